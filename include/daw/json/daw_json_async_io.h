@@ -0,0 +1,119 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include <daw/daw_string_view.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace daw::json {
+	/// @brief Reads a file on a background thread into a ring of blocks, so
+	/// the next blocks are already loaded while the current one is parsed.
+	/// Blocks are handed out in file order with next_block
+	class json_async_file_reader_t {
+		struct block_t {
+			std::unique_ptr<char[]> data;
+			size_t size;
+		};
+
+		std::vector<block_t> m_blocks;
+		size_t m_block_size;
+		int m_fd;
+		std::mutex m_mutex{ };
+		std::condition_variable m_cv{ };
+		// Blocks that have been read and not yet released by the consumer
+		size_t m_ready = 0;
+		// Index of the block returned by the last call to next_block
+		size_t m_current = 0;
+		bool m_has_current = false;
+		bool m_is_eof = false;
+		bool m_is_closing = false;
+		std::exception_ptr m_error{ };
+		std::thread m_thread{ };
+
+		void read_blocks( );
+
+	public:
+		static constexpr size_t default_block_size = 1024U * 1024U;
+		static constexpr size_t default_blocks_in_flight = 4;
+
+		/// @param block_size bytes per read
+		/// @param blocks_in_flight blocks that may be read ahead of the parser
+		/// @throws std::runtime_error if the file cannot be opened
+		explicit json_async_file_reader_t(
+		  daw::string_view file_name, size_t block_size = default_block_size,
+		  size_t blocks_in_flight = default_blocks_in_flight );
+
+		~json_async_file_reader_t( );
+		json_async_file_reader_t( json_async_file_reader_t const & ) = delete;
+		json_async_file_reader_t &
+		operator=( json_async_file_reader_t const & ) = delete;
+		json_async_file_reader_t( json_async_file_reader_t && ) = delete;
+		json_async_file_reader_t &
+		operator=( json_async_file_reader_t && ) = delete;
+
+		/// @brief Release the previous block and wait for the next one
+		/// @return the block, empty at the end of the file.  It is valid until
+		/// the next call
+		/// @throws std::runtime_error if a read failed
+		daw::string_view next_block( );
+	}; // json_async_file_reader_t
+
+	/// @brief Writes buffers to a file on a background thread so that
+	/// serializing the next buffer overlaps writing the last one.  At most
+	/// max_queued buffers wait to be written, write blocks beyond that
+	class json_async_file_writer_t {
+		std::deque<std::string> m_queue{ };
+		size_t m_max_queued;
+		int m_fd;
+		std::mutex m_mutex{ };
+		std::condition_variable m_cv{ };
+		bool m_is_closing = false;
+		std::exception_ptr m_error{ };
+		std::thread m_thread{ };
+
+		void write_buffers( );
+		void join( );
+
+	public:
+		static constexpr size_t default_max_queued = 8;
+
+		/// @brief Create or truncate file_name
+		/// @throws std::runtime_error if the file cannot be opened
+		explicit json_async_file_writer_t(
+		  daw::string_view file_name, size_t max_queued = default_max_queued );
+
+		/// @brief Waits for queued buffers to be written.  Errors are lost, call
+		/// close to see them
+		~json_async_file_writer_t( );
+		json_async_file_writer_t( json_async_file_writer_t const & ) = delete;
+		json_async_file_writer_t &
+		operator=( json_async_file_writer_t const & ) = delete;
+		json_async_file_writer_t( json_async_file_writer_t && ) = delete;
+		json_async_file_writer_t &
+		operator=( json_async_file_writer_t && ) = delete;
+
+		/// @brief Queue buffer to be written after the ones before it
+		/// @throws std::runtime_error if an earlier write failed or the writer
+		/// was closed
+		void write( std::string buffer );
+
+		/// @brief Wait for every queued buffer to be written and close the file
+		/// @throws std::runtime_error if a write failed
+		void close( );
+	}; // json_async_file_writer_t
+} // namespace daw::json
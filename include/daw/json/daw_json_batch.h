@@ -0,0 +1,50 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include "daw_json_parser.h"
+
+#include <daw/daw_string_view.h>
+
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace daw::json {
+	/// @brief Outcome of parsing one file with parse_files
+	struct json_file_result_t {
+		std::string path;
+		/// @brief The parsed document, null when error is set
+		json_obj value;
+		/// @brief Why the file could not be opened or parsed, empty on success
+		std::exception_ptr error;
+
+		bool has_error( ) const noexcept {
+			return static_cast<bool>( error );
+		}
+	};
+
+	/// @brief Open, map and parse many files concurrently.  Each worker holds
+	/// one file at a time, so at most max_in_flight files are mapped at once.
+	/// A file that fails does not stop the others
+	/// @param paths files to parse
+	/// @param max_in_flight maximum number of files being parsed at once, 0 for
+	/// one per core
+	/// @return one result per path, in the order of paths
+	std::vector<json_file_result_t>
+	parse_files( std::vector<std::string> const &paths,
+	             size_t max_in_flight = 0 );
+
+	/// @brief parse_files over the regular files directly inside directory,
+	/// ordered by path
+	/// @throws std::runtime_error if directory cannot be read
+	std::vector<json_file_result_t>
+	parse_directory( daw::string_view directory, size_t max_in_flight = 0 );
+} // namespace daw::json
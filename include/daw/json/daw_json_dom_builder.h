@@ -0,0 +1,57 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include "daw_json_parser_v2.h"
+#include "daw_json_value_t.h"
+
+#include <daw/daw_string_view.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace daw::json {
+	/// @brief json_parser handler that builds json_value_t's.  Open arrays and
+	/// objects are kept on an explicit stack and filled in place, each is
+	/// created once and moved into its parent when it closes
+	class json_dom_builder_t {
+		std::vector<json_value_t> m_open{ };
+		// Member name waiting for its value, one per open object
+		std::vector<json_string_value> m_keys{ };
+		std::vector<json_value_t> m_values{ };
+
+		void add_value( json_value_t value );
+		void close_container( );
+
+	public:
+		json_dom_builder_t( ) = default;
+
+		void on_object_begin( );
+		void on_object_end( );
+		void on_array_begin( );
+		void on_array_end( );
+		void on_key( daw::string_view key );
+		void on_string( daw::string_view value );
+		void on_integer( daw::string_view, intmax_t value );
+		void on_real( daw::string_view, double value );
+		void on_boolean( bool value );
+		void on_null( );
+
+		/// @brief Completed top level values in document order
+		std::vector<json_value_t> &values( ) noexcept;
+
+		/// @brief Move out the only top level value
+		/// @throws json_parser_exception if there is not exactly one
+		json_value_t take_value( );
+	}; // json_dom_builder_t
+
+	/// @brief Parse json_text with json_parser into a json_value_t
+	/// @throws json_parser_exception if the text is not a single json value
+	json_value_t build_json_value( daw::string_view json_text );
+} // namespace daw::json
@@ -0,0 +1,98 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include <daw/daw_memory_mapped_file.h>
+#include <daw/daw_string_view.h>
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string>
+
+namespace daw::json {
+	/// @brief true when data starts with the gzip magic bytes 0x1F 0x8B
+	bool is_gzip_data( daw::string_view data ) noexcept;
+
+	/// @brief Inflate a gzip stream into memory.  The parsers need the whole
+	/// document as contiguous text, so the result is not streamed into them.
+	/// Memory is reserved from the size recorded in the gzip trailer
+	/// @throws std::runtime_error if the data is corrupt or truncated, including
+	/// a missing or mismatched CRC/ISIZE trailer
+	std::string gzip_decompress( daw::string_view compressed_data );
+
+	/// @brief Read only view of the text of a json file.  Plain files are
+	/// memory mapped and used in place.  Gzip files are recognized by their
+	/// magic bytes, not their extension, and are inflated while reading.
+	/// An existing empty file cannot be mapped but is still valid, with empty
+	/// text
+	class json_file_t {
+		daw::filesystem::memory_mapped_file_t<char> m_file;
+		std::string m_inflated;
+		bool m_is_compressed;
+		bool m_is_empty;
+
+	public:
+		explicit json_file_t( daw::string_view file_name );
+
+		~json_file_t( );
+		json_file_t( json_file_t const & ) = delete;
+		json_file_t &operator=( json_file_t const & ) = delete;
+		json_file_t( json_file_t && ) = default;
+		json_file_t &operator=( json_file_t && ) = default;
+
+		explicit operator bool( ) const noexcept;
+		bool is_compressed( ) const noexcept;
+
+		char const *begin( ) const noexcept;
+		char const *end( ) const noexcept;
+		size_t size( ) const noexcept;
+		daw::string_view to_string_view( ) const noexcept;
+	}; // json_file_t
+
+	/// @brief Reads a stream or file descriptor a block at a time into one
+	/// reused buffer, so a parser can work on contiguous text with bounded
+	/// memory, e.g. from stdin or a pipe.  Streams are read through their
+	/// streambuf with one call per block rather than one per character
+	class json_block_source_t {
+		std::unique_ptr<char[]> m_buffer;
+		size_t m_block_size;
+		std::istream *m_stream;
+		int m_fd;
+
+	public:
+		static constexpr size_t default_block_size = 64U * 1024U;
+
+		explicit json_block_source_t( std::istream &is,
+		                              size_t block_size = default_block_size );
+
+		/// @param fd open file descriptor, it is not closed
+		explicit json_block_source_t( int fd,
+		                              size_t block_size = default_block_size );
+
+		/// @brief Read the next block
+		/// @return the data read, empty at the end of input.  It is valid until
+		/// the next call
+		/// @throws std::runtime_error when reading a file descriptor fails
+		daw::string_view next_block( );
+	}; // json_block_source_t
+
+	/// @brief Read everything that is left in source
+	std::string read_all( json_block_source_t &source );
+
+	/// @brief Write json text to a file
+	/// @param file_name path of file to create
+	/// @param json_text text to write
+	/// @param overwrite replace an existing file, otherwise throw when it exists
+	/// @param compress write the file gzip compressed
+	/// @throws std::runtime_error if the file cannot be opened or written
+	void write_json_file( daw::string_view file_name,
+	                      daw::string_view json_text, bool overwrite,
+	                      bool compress );
+} // namespace daw::json
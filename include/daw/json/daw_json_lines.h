@@ -0,0 +1,179 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include "daw_json_file.h"
+#include "daw_json_parallel.h"
+#include "daw_json_parser_exception.h"
+#include "daw_json_parser_impl.h"
+
+#include <daw/daw_string_view.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace daw::json {
+	/// @brief Order in which json_lines_parser hands finished records over
+	enum class json_lines_order_t {
+		/// Records are delivered in the order of the lines they came from
+		in_order,
+		/// Records are delivered as soon as their chunk is parsed
+		unordered
+	};
+
+	namespace impl {
+		/// @brief Parse the single json value in line, anything but whitespace
+		/// after it is an error unless the handler stopped the parse
+		template<typename Handler>
+		void parse_json_line( daw::string_view line, Handler &handler ) {
+			auto state = parser_proxy_t<Handler>( handler );
+			auto first = line.data( );
+			auto const last = line.data( ) + line.size( );
+			first = parse_value( first, last, state );
+			if( state.is_stopped( ) ) {
+				return;
+			}
+			first = skip_whitespace( first, last );
+			if( first != last ) {
+				throw json_parser_exception( "Unexpected data after the record" );
+			}
+		}
+
+		/// @brief true when the line holds nothing but whitespace
+		inline bool is_blank_line( daw::string_view line ) noexcept {
+			return std::all_of( line.begin( ), line.end( ), []( char c ) {
+				return is_insignificant_ws( c );
+			} );
+		}
+
+		/// @brief The line holding position of data, counting from 1
+		inline size_t line_number_at( daw::string_view data, size_t position ) {
+			return 1 + static_cast<size_t>( std::count(
+			             data.data( ), data.data( ) + position, '\n' ) );
+		}
+
+		/// @brief Position of the first line starting at or after position
+		inline size_t next_line_start( daw::string_view data,
+		                               size_t position ) noexcept {
+			if( position == 0 ) {
+				return 0;
+			}
+			auto const nl = static_cast<char const *>( std::memchr(
+			  data.data( ) + position - 1, '\n', data.size( ) - position + 1 ) );
+			return nl == nullptr ? data.size( )
+			                     : static_cast<size_t>( nl - data.data( ) ) + 1;
+		}
+	} // namespace impl
+
+	/// @brief Parse newline delimited json (JSON Lines) with one record per
+	/// line, spreading the lines over up to thread_count threads.  Each record
+	/// is parsed into a fresh handler from make_handler, and finished handlers
+	/// are passed to deliver.  deliver is only ever called by one thread at a
+	/// time.  Blank lines are skipped
+	/// @param data the whole input, e.g. a memory mapped file
+	/// @param make_handler callable returning a new SAX handler
+	/// @param deliver callable taking a Handler && for each record
+	/// @param order whether records must be delivered in input order
+	/// @param thread_count maximum number of threads to use, 0 for all cores
+	/// @throws json_parser_exception naming the line of the first record that
+	/// failed.  Records already delivered stay delivered
+	template<typename MakeHandler, typename Deliver>
+	void json_lines_parser(
+	  daw::string_view data, MakeHandler make_handler, Deliver deliver,
+	  json_lines_order_t order = json_lines_order_t::in_order,
+	  size_t thread_count = 0 ) {
+
+		using handler_t = std::decay_t<decltype( make_handler( ) )>;
+		constexpr size_t min_chunk_bytes = 1024U * 1024U;
+		if( thread_count == 0 ) {
+			thread_count = impl::default_thread_count( );
+		}
+		// Chunks are byte ranges, each owns the lines that start within it
+		auto const chunk_bytes =
+		  std::max( data.size( ) / ( thread_count * 4U ), min_chunk_bytes );
+		auto const chunk_count = ( data.size( ) + chunk_bytes - 1 ) / chunk_bytes;
+
+		std::mutex deliver_mutex{ };
+		std::vector<std::vector<handler_t>> finished( chunk_count );
+		std::vector<bool> is_finished( chunk_count, false );
+		size_t next_to_deliver = 0;
+
+		auto const deliver_all = [&deliver]( std::vector<handler_t> &records ) {
+			for( auto &record : records ) {
+				deliver( std::move( record ) );
+			}
+			records = std::vector<handler_t>( );
+		};
+
+		impl::parallel_for_chunks(
+		  data.size( ), chunk_bytes, thread_count,
+		  [&]( size_t first, size_t last, size_t chunk ) {
+			  std::vector<handler_t> records{ };
+			  auto line_first = impl::next_line_start( data, first );
+			  while( line_first < last ) {
+				  auto const nl = static_cast<char const *>(
+				    std::memchr( data.data( ) + line_first, '\n',
+				                 data.size( ) - line_first ) );
+				  auto const line_last =
+				    nl == nullptr ? data.size( )
+				                  : static_cast<size_t>( nl - data.data( ) );
+				  auto const line = daw::string_view( data.data( ) + line_first,
+				                                      line_last - line_first );
+				  if( not impl::is_blank_line( line ) ) {
+					  records.push_back( make_handler( ) );
+					  try {
+						  impl::parse_json_line( line, records.back( ) );
+					  } catch( std::exception const &ex ) {
+						  throw json_parser_exception(
+						    "Error parsing json line " +
+						    std::to_string( impl::line_number_at( data, line_first ) ) +
+						    ": " + ex.what( ) );
+					  }
+				  }
+				  line_first = line_last + 1;
+			  }
+
+			  std::lock_guard<std::mutex> lock( deliver_mutex );
+			  if( order == json_lines_order_t::unordered ) {
+				  deliver_all( records );
+				  return;
+			  }
+			  finished[chunk] = std::move( records );
+			  is_finished[chunk] = true;
+			  while( next_to_deliver < chunk_count and
+			         is_finished[next_to_deliver] ) {
+				  deliver_all( finished[next_to_deliver] );
+				  ++next_to_deliver;
+			  }
+		  } );
+	}
+
+	/// @brief json_lines_parser over a file.  Plain files are memory mapped,
+	/// gzip files are inflated into memory first
+	template<typename MakeHandler, typename Deliver>
+	void json_lines_from_file(
+	  daw::string_view file_name, MakeHandler make_handler, Deliver deliver,
+	  json_lines_order_t order = json_lines_order_t::in_order,
+	  size_t thread_count = 0 ) {
+
+		json_file_t const file( file_name );
+		if( not file ) {
+			throw json_parser_exception( "Could not open file" );
+		}
+		json_lines_parser( file.to_string_view( ), std::move( make_handler ),
+		                   std::move( deliver ), order, thread_count );
+	}
+} // namespace daw::json
@@ -8,7 +8,11 @@
 
 #pragma once
 
+#include "daw_json_file.h"
+#include "daw_json_parallel.h"
 #include "daw_json_parser.h"
+#include "daw_json_perfect_hash.h"
+#include "daw_json_text_parser.h"
 #include "daw_json_value_t.h"
 
 #include <daw/cpp_17.h>
@@ -28,6 +32,7 @@
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -92,6 +97,74 @@ namespace daw::json {
 				result += ']';
 				return result;
 			}
+
+			/// @brief Serialize the elements of a random access container in
+			/// chunks on several threads.  Each chunk gets its own buffer and the
+			/// buffers are returned in element order, with the separating commas
+			/// already in place
+			/// @param container random access container of values
+			/// @param append_func function with signature
+			/// void( std::string &, value_type const & ) that appends the json
+			/// text of one element
+			/// @param thread_count maximum number of threads, 0 for all cores
+			template<typename Container, typename AppendFunction>
+			std::vector<std::string>
+			to_json_array_chunks( Container const &container,
+			                      AppendFunction append_func,
+			                      size_t thread_count ) {
+				auto const item_count = container.size( );
+				auto const chunk_size =
+				  parallel_chunk_size( item_count, thread_count );
+				std::vector<std::string> chunks( ( item_count + chunk_size - 1 ) /
+				                                 chunk_size );
+				parallel_for_chunks(
+				  item_count, chunk_size, thread_count,
+				  [&]( size_t first, size_t last, size_t chunk ) {
+					  auto &buffer = chunks[chunk];
+					  for( auto n = first; n < last; ++n ) {
+						  if( n != 0 ) {
+							  buffer += ',';
+						  }
+						  append_func( buffer, container[n] );
+					  }
+				  } );
+				return chunks;
+			}
+
+			template<typename Container, typename AppendFunction>
+			std::string to_json_array_parallel( Container const &container,
+			                                    AppendFunction append_func,
+			                                    size_t thread_count ) {
+				auto const chunks =
+				  to_json_array_chunks( container, append_func, thread_count );
+				size_t result_size = 2;
+				for( auto const &chunk : chunks ) {
+					result_size += chunk.size( );
+				}
+				std::string result;
+				result.reserve( result_size );
+				result += '[';
+				for( auto const &chunk : chunks ) {
+					result += chunk;
+				}
+				result += ']';
+				return result;
+			}
+
+			template<typename Container, typename AppendFunction>
+			void to_json_array_parallel( std::ostream &os,
+			                             Container const &container,
+			                             AppendFunction append_func,
+			                             size_t thread_count ) {
+				auto const chunks =
+				  to_json_array_chunks( container, append_func, thread_count );
+				os << '[';
+				for( auto const &chunk : chunks ) {
+					os.write( chunk.data( ),
+					          static_cast<std::streamsize>( chunk.size( ) ) );
+				}
+				os << ']';
+			}
 		} // namespace impl
 
 		template<typename Container>
@@ -166,13 +239,50 @@ namespace daw::json {
 		template<typename Vector, typename Function>
 		void copy_array( json_array_value const &source, Vector &destination,
 		                 Function func ) {
-			destination.clear( );
 			using value_type = std::decay_t<decltype( *std::begin( destination ) )>;
-			std::transform(
-			  std::begin( source ), std::end( source ),
-			  std::back_inserter( destination ), [&func]( auto const &v ) {
-				  value_type dest_v = static_cast<value_type>( func( v ) );
-				  return dest_v;
+			// Assign over the existing elements so their storage is reused
+			destination.resize( source.size( ) );
+			for( size_t n = 0; n < source.size( ); ++n ) {
+				destination[n] = static_cast<value_type>( func( source[n] ) );
+			}
+		}
+
+		/// @brief Decode the array at the front of rng into destination, one
+		/// element at a time with decode( element, rng ).  Elements already in
+		/// destination are overwritten rather than destroyed so that their
+		/// capacity is reused, and the vector's own capacity is kept
+		template<typename Vector, typename DecodeFunction>
+		void parse_array_into( text::text_range_t &rng, Vector &destination,
+		                       DecodeFunction decode ) {
+			size_t count = 0;
+			text::parse_array( rng, [&]( text::text_range_t &element_rng ) {
+				if( count == destination.size( ) ) {
+					destination.emplace_back( );
+				}
+				decode( destination[count], element_rng );
+				++count;
+			} );
+			destination.resize( count );
+		}
+
+		/// @brief Decodes the array at the front of the text being parsed
+		/// directly into destination
+		/// @tparam Vector a std::vector<T> where T is an integer, real, boolean or
+		/// string
+		/// @param source array in the json text
+		/// @param destination destination vector
+		template<typename Vector, typename Function>
+		void copy_array( text::array_source_t const &source, Vector &destination,
+		                 Function ) {
+			using value_type = std::decay_t<decltype( *std::begin( destination ) )>;
+			parse_array_into(
+			  *source.range, destination,
+			  []( auto &&element, text::text_range_t &rng ) {
+				  if constexpr( std::is_same_v<value_type, std::string> ) {
+					  text::parse_string( rng, element );
+				  } else {
+					  element = text::parse_as<value_type>( rng );
+				  }
 			  } );
 		}
 	} // namespace impl
@@ -200,15 +310,278 @@ namespace daw::json {
 		}
 	};
 
+	namespace impl {
+		template<typename T>
+		struct is_std_vector : std::false_type {};
+
+		template<typename T, typename Alloc>
+		struct is_std_vector<std::vector<T, Alloc>> : std::true_type {};
+
+		template<typename T>
+		inline constexpr bool is_json_link_v = std::is_base_of_v<json_link<T>, T>;
+
+		/// @brief The link_types_t::types_t mask for a member of type T, 0 when T
+		/// cannot be mapped
+		template<typename T>
+		constexpr uint8_t member_kind( ) noexcept {
+			if constexpr( std::is_same_v<T, bool> ) {
+				return link_types_t::boolean;
+			} else if constexpr( std::is_integral_v<T> ) {
+				return link_types_t::integer;
+			} else if constexpr( std::is_floating_point_v<T> ) {
+				return link_types_t::real;
+			} else if constexpr( std::is_constructible_v<T, std::string> and
+			                     std::is_convertible_v<T, std::string> ) {
+				return link_types_t::string;
+			} else if constexpr( is_std_vector<T>::value ) {
+				constexpr auto element_kind = member_kind<typename T::value_type>( );
+				if constexpr( element_kind == 0 or
+				              ( element_kind & link_types_t::array ) != 0 ) {
+					return 0;
+				} else {
+					return static_cast<uint8_t>( link_types_t::array | element_kind );
+				}
+			} else if constexpr( is_json_link_v<T> ) {
+				return link_types_t::object;
+			} else {
+				return 0;
+			}
+		}
+
+		template<typename T>
+		void append_member_value( std::string &json_text, T const &value ) {
+			if constexpr( std::is_same_v<T, bool> ) {
+				json_text += to_json_boolean( value );
+			} else if constexpr( std::is_integral_v<T> ) {
+				json_text += to_json_integer( value );
+			} else if constexpr( std::is_floating_point_v<T> ) {
+				json_text += to_json_real( value );
+			} else if constexpr( is_std_vector<T>::value ) {
+				json_text += '[';
+				bool is_first = true;
+				for( auto const &item : value ) {
+					if( is_first ) {
+						is_first = false;
+					} else {
+						json_text += ',';
+					}
+					append_member_value( json_text, item );
+				}
+				json_text += ']';
+			} else if constexpr( is_json_link_v<T> ) {
+				value.append_json_string( json_text );
+			} else {
+				json_text += to_json_string( static_cast<std::string>( value ) );
+			}
+		}
+
+		template<typename T>
+		void parse_member_value( T &dest, text::text_range_t &rng ) {
+			if constexpr( std::is_same_v<T, bool> ) {
+				dest = text::parse_boolean( rng );
+			} else if constexpr( std::is_integral_v<T> ) {
+				auto const v = text::parse_integer( rng );
+				if( not can_fit<T>( v ) ) {
+					text::throw_parse_error( "Integer does not fit in member type" );
+				}
+				dest = static_cast<T>( v );
+			} else if constexpr( std::is_floating_point_v<T> ) {
+				dest = static_cast<T>( text::parse_real( rng ) );
+			} else if constexpr( std::is_same_v<T, std::string> ) {
+				text::parse_string( rng, dest );
+			} else if constexpr( is_std_vector<T>::value ) {
+				parse_array_into(
+				  rng, dest, []( auto &&element, text::text_range_t &element_rng ) {
+					  if constexpr( std::is_same_v<typename T::value_type, bool> ) {
+						  // std::vector<bool> elements are proxies
+						  element = text::parse_boolean( element_rng );
+					  } else {
+						  parse_member_value( element, element_rng );
+					  }
+				  } );
+			} else if constexpr( is_json_link_v<T> ) {
+				T::from_json_text( dest, rng );
+			} else {
+				dest = T( text::parse_string( rng ) );
+			}
+		}
+
+		template<typename T>
+		void set_member_value( T &dest, json_value_t const &value ) {
+			if constexpr( std::is_same_v<T, bool> ) {
+				dest = value.get_boolean( );
+			} else if constexpr( std::is_integral_v<T> ) {
+				auto const v = value.get_integer( );
+				daw::exception::precondition_check(
+				  can_fit<T>( v ), "Integer does not fit in member type" );
+				dest = static_cast<T>( v );
+			} else if constexpr( std::is_floating_point_v<T> ) {
+				dest = static_cast<T>( value.get_real( ) );
+			} else if constexpr( is_std_vector<T>::value ) {
+				auto const &source = value.get_array( );
+				dest.resize( source.size( ) );
+				for( size_t n = 0; n < source.size( ); ++n ) {
+					if constexpr( std::is_same_v<typename T::value_type, bool> ) {
+						dest[n] = source[n].get_boolean( );
+					} else {
+						set_member_value( dest[n], source[n] );
+					}
+				}
+			} else if constexpr( is_json_link_v<T> ) {
+				dest = T::from_json_value( value );
+			} else {
+				dest = T( value.get_string( ) );
+			}
+		}
+
+		/// @brief Check that the value at the front of rng could be decoded into
+		/// a T, without decoding it.  Integers must fit in T
+		template<typename T>
+		bool validate_value( text::text_range_t &rng ) {
+			if constexpr( std::is_same_v<T, bool> ) {
+				return text::check_boolean( rng );
+			} else if constexpr( std::is_integral_v<T> ) {
+				using integer_t = json_value_t::integer_t;
+				constexpr auto min_value = static_cast<integer_t>(
+				  std::numeric_limits<T>::min( ) );
+				constexpr auto max_value =
+				  std::numeric_limits<T>::max( ) >
+				      static_cast<std::make_unsigned_t<integer_t>>(
+				        std::numeric_limits<integer_t>::max( ) )
+				    ? std::numeric_limits<integer_t>::max( )
+				    : static_cast<integer_t>( std::numeric_limits<T>::max( ) );
+				return text::check_integer( rng, min_value, max_value );
+			} else if constexpr( std::is_floating_point_v<T> ) {
+				return text::check_number( rng );
+			} else if constexpr( is_json_link_v<T> ) {
+				return T::validate_text( rng );
+			} else if constexpr( std::is_constructible_v<T, std::string> ) {
+				return text::check_string( rng );
+			} else {
+				// value_type rather than the dereferenced iterator, which is a
+				// proxy for std::vector<bool>
+				using element_t = typename T::value_type;
+				return text::check_array( rng, []( text::text_range_t &element_rng ) {
+					return validate_value<element_t>( element_rng );
+				} );
+			}
+		}
+
+		/// @brief Tracks which members of a type have been seen while
+		/// validating one object.  Types with up to 256 members need no
+		/// allocation
+		class seen_members_t {
+			static constexpr size_t inline_words = 4;
+			uint64_t m_inline[inline_words] = { };
+			std::vector<uint64_t> m_heap{ };
+			uint64_t *m_words;
+			size_t m_count;
+
+		public:
+			explicit seen_members_t( size_t member_count )
+			  : m_words( m_inline )
+			  , m_count( member_count ) {
+				auto const word_count = ( member_count + 63U ) / 64U;
+				if( word_count > inline_words ) {
+					m_heap.resize( word_count );
+					m_words = m_heap.data( );
+				}
+			}
+
+			seen_members_t( seen_members_t const & ) = delete;
+			seen_members_t &operator=( seen_members_t const & ) = delete;
+
+			void set( size_t n ) noexcept {
+				m_words[n / 64U] |= uint64_t{ 1 } << ( n % 64U );
+			}
+
+			bool all( ) const noexcept {
+				for( size_t n = 0; n < m_count / 64U; ++n ) {
+					if( m_words[n] != ~uint64_t{ 0 } ) {
+						return false;
+					}
+				}
+				auto const rem = m_count % 64U;
+				return rem == 0 or
+				       m_words[m_count / 64U] == ( uint64_t{ 1 } << rem ) - 1U;
+			}
+		}; // seen_members_t
+	} // namespace impl
+
+	/// @brief Compile time description of one mapped data member.  A type
+	/// whose static constexpr json_members( ) returns a std::tuple of these is
+	/// encoded and decoded without the runtime map used by map_to_json( )
+	template<typename Class, typename Member>
+	struct json_member_t {
+		using class_t = Class;
+		using member_t = Member;
+
+		/// link_types_t::types_t mask deduced from the member type
+		static constexpr uint8_t kind = impl::member_kind<Member>( );
+		static_assert( kind != 0, "Member type cannot be mapped to json" );
+
+		daw::string_view name;
+		Member Class::*member;
+	}; // json_member_t
+
+	/// @brief Describe a data member for json_members( )
+	/// @param name json member name
+	/// @param member pointer to the data member
+	template<typename Class, typename Member>
+	constexpr json_member_t<Class, Member>
+	json_member( daw::string_view name, Member Class::*member ) noexcept {
+		return json_member_t<Class, Member>{ name, member };
+	}
+
+	namespace impl {
+		template<typename Derived, typename = void>
+		struct has_json_members : std::false_type {};
+
+		template<typename Derived>
+		struct has_json_members<Derived,
+		                        std::void_t<decltype( Derived::json_members( ) )>>
+		  : std::true_type {};
+
+		template<typename Derived>
+		inline constexpr bool has_json_members_v =
+		  has_json_members<Derived>::value;
+
+		template<typename Members, typename Function, size_t... Is>
+		constexpr void visit_json_member( Members const &members, size_t index,
+		                                  Function &&func,
+		                                  std::index_sequence<Is...> ) {
+			(void)( ( Is == index ? ( func( std::get<Is>( members ) ), true )
+			                      : false ) or
+			        ... );
+		}
+
+		/// @brief Call func( member ) on the member at position index of the
+		/// members tuple.  The index is compared as an integer, the names are
+		/// not looked at
+		template<typename Members, typename Function>
+		constexpr void visit_json_member( Members const &members, size_t index,
+		                                  Function &&func ) {
+			visit_json_member(
+			  members, index, func,
+			  std::make_index_sequence<std::tuple_size_v<Members>>{ } );
+		}
+	} // namespace impl
+
 	template<typename Derived>
 	class json_link {
 		using serialize_function_t = std::function<std::string( Derived const & )>;
 		using deserialize_function_t =
 		  std::function<void( Derived &, json_value_t const & )>;
+		using parse_function_t =
+		  std::function<void( Derived &, impl::text::text_range_t & )>;
+		using validate_function_t = bool ( * )( impl::text::text_range_t & );
 
 		struct mapping_functions_t {
 			serialize_function_t serialize_function;
 			deserialize_function_t deserialize_function;
+			parse_function_t parse_function;
+			validate_function_t validate_function = nullptr;
+			size_t member_number = 0;
 		}; // mapping_functions_t
 
 		static auto &get_map( ) {
@@ -216,9 +589,80 @@ namespace daw::json {
 			return s_maps;
 		}
 
+		using member_index_t =
+		  impl::perfect_hash_map_t<mapping_functions_t const *>;
+
+		/// @brief Build the perfect hash used to find the mapping for a member
+		/// name once all members are registered
+		static member_index_t build_member_index( ) {
+			std::vector<std::pair<std::string, mapping_functions_t const *>> items{ };
+			items.reserve( get_map( ).size( ) );
+			for( auto &kv : get_map( ) ) {
+				kv.second.member_number = items.size( );
+				items.emplace_back( kv.first, &kv.second );
+			}
+			return member_index_t( daw::move( items ) );
+		}
+
+		/// @brief Registers the members on first use.  The initialization of a
+		/// function local static runs exactly once even when several threads
+		/// get here together, and the map is never written after that, so
+		/// readers need no further synchronization
+		static member_index_t const &get_member_index( ) {
+			static member_index_t const s_index = []( ) {
+				if constexpr( not impl::has_json_members_v<Derived> ) {
+					Derived::map_to_json( );
+				}
+				return build_member_index( );
+			}( );
+			return s_index;
+		}
+
+		using member_table_index_t = impl::perfect_hash_map_t<size_t>;
+
+		/// @brief Perfect hash from the names in json_members( ) to their
+		/// position in the tuple, built on first use.  When a name repeats the
+		/// first member with that name wins
+		static member_table_index_t const &get_member_table_index( ) {
+			static member_table_index_t const s_index = []( ) {
+				std::vector<std::pair<std::string, size_t>> items{ };
+				std::apply(
+				  [&items]( auto const &... member ) {
+					  ( items.emplace_back(
+					      std::string( member.name.data( ), member.name.size( ) ),
+					      items.size( ) ),
+					    ... );
+				  },
+				  Derived::json_members( ) );
+				std::vector<std::pair<std::string, size_t>> unique_items{ };
+				for( auto &item : items ) {
+					auto const is_duplicate = std::any_of(
+					  unique_items.begin( ), unique_items.end( ),
+					  [&item]( auto const &u ) { return u.first == item.first; } );
+					if( not is_duplicate ) {
+						unique_items.push_back( daw::move( item ) );
+					}
+				}
+				return member_table_index_t( daw::move( unique_items ) );
+			}( );
+			return s_index;
+		}
+
+		/// @brief Call func( member ) on the json_members( ) entry called name
+		/// @return false when no member has that name
+		template<typename Function>
+		static bool find_table_member( daw::string_view name, Function &&func ) {
+			auto const index = get_member_table_index( ).find( name );
+			if( not index ) {
+				return false;
+			}
+			impl::visit_json_member( Derived::json_members( ), *index, func );
+			return true;
+		}
+
 		static void check_json_maps( ) {
-			if( get_map( ).empty( ) ) {
-				Derived::map_to_json( );
+			if constexpr( not impl::has_json_members_v<Derived> ) {
+				(void)get_member_index( );
 			}
 		}
 
@@ -234,6 +678,58 @@ namespace daw::json {
 			return *static_cast<Derived const *>( this );
 		}
 
+		static std::string unescaped_name( daw::string_view name ) {
+			std::string result{ };
+			impl::text::unescape_string( name, result );
+			return result;
+		}
+
+		/// @brief Non throwing unescape for the validator.  On success name
+		/// refers to the unescaped text held in buffer
+		static bool unescape_name( daw::string_view &name,
+		                           std::string &buffer ) noexcept {
+			try {
+				impl::text::unescape_string( name, buffer );
+			} catch( ... ) {
+				return false;
+			}
+			name = daw::string_view( buffer.data( ), buffer.size( ) );
+			return true;
+		}
+
+		template<typename Member>
+		[[noreturn]] static void member_error( Member const &member,
+		                                       std::exception const &ex ) {
+			auto const name = std::string( member.name.data( ), member.name.size( ) );
+			std::string msg =
+			  "Exception while deserializing member '" + name + "': " + ex.what( );
+			throw std::runtime_error( msg );
+		}
+
+		template<typename D, typename Member>
+		static void parse_member( D &result, impl::text::text_range_t &rng,
+		                          Member const &member ) {
+			try {
+				impl::parse_member_value( result.*member.member, rng );
+			} catch( std::exception const &ex ) {
+				member_error( member, ex );
+			}
+		}
+
+		template<typename D, typename Member>
+		static void set_member_from_object( D &result, json_object_value const &obj,
+		                                    Member const &member ) {
+			auto const it = obj.find( member.name );
+			if( it == obj.end( ) ) {
+				return;
+			}
+			try {
+				impl::set_member_value( result.*member.member, it->second );
+			} catch( std::exception const &ex ) {
+				member_error( member, ex );
+			}
+		}
+
 	protected:
 		json_link( ) = default;
 
@@ -254,6 +750,16 @@ namespace daw::json {
 				  set_function( obj, daw::move( v ) );
 			  };
 
+			mapping_functions.parse_function =
+			  [set_function]( Derived &obj, impl::text::text_range_t &rng ) mutable {
+				  json_value_t::integer_t v = impl::text::parse_integer( rng );
+				  assert( impl::can_fit<decltype( get_function( obj ) )>( v ) );
+				  set_function( obj, daw::move( v ) );
+			  };
+
+			mapping_functions.validate_function = &impl::validate_value<
+			  std::decay_t<std::invoke_result_t<GetFunction, Derived const &>>>;
+
 			add_json_map( name, daw::move( mapping_functions ) );
 		}
 
@@ -272,6 +778,14 @@ namespace daw::json {
 				  set_function( obj, value.get_real( ) );
 			  };
 
+			mapping_functions.parse_function =
+			  [set_function]( Derived &obj, impl::text::text_range_t &rng ) mutable {
+				  set_function( obj, impl::text::parse_real( rng ) );
+			  };
+
+			mapping_functions.validate_function = &impl::validate_value<
+			  std::decay_t<std::invoke_result_t<GetFunction, Derived const &>>>;
+
 			add_json_map( name, daw::move( mapping_functions ) );
 		}
 
@@ -291,6 +805,18 @@ namespace daw::json {
 				  set_function( obj, value.get_string( ) );
 			  };
 
+			mapping_functions.parse_function =
+			  [set_function]( Derived &obj, impl::text::text_range_t &rng ) mutable {
+				  // Copy assigning from a reused buffer lets the member keep its
+				  // capacity
+				  auto &buffer = impl::text::scratch_string( );
+				  impl::text::parse_string( rng, buffer );
+				  set_function( obj, buffer );
+			  };
+
+			mapping_functions.validate_function = &impl::validate_value<
+			  std::decay_t<std::invoke_result_t<GetFunction, Derived const &>>>;
+
 			add_json_map( name, daw::move( mapping_functions ) );
 		}
 
@@ -309,6 +835,14 @@ namespace daw::json {
 				  set_function( obj, value.get_boolean( ) );
 			  };
 
+			mapping_functions.parse_function =
+			  [set_function]( Derived &obj, impl::text::text_range_t &rng ) mutable {
+				  set_function( obj, impl::text::parse_boolean( rng ) );
+			  };
+
+			mapping_functions.validate_function = &impl::validate_value<
+			  std::decay_t<std::invoke_result_t<GetFunction, Derived const &>>>;
+
 			add_json_map( name, daw::move( mapping_functions ) );
 		}
 
@@ -326,6 +860,14 @@ namespace daw::json {
 				  set_function( obj, value.get_array( ) );
 			  };
 
+			mapping_functions.parse_function =
+			  [set_function]( Derived &obj, impl::text::text_range_t &rng ) mutable {
+				  set_function( obj, impl::text::array_source_t{ &rng } );
+			  };
+
+			mapping_functions.validate_function = &impl::validate_value<
+			  std::decay_t<std::invoke_result_t<GetFunction, Derived const &>>>;
+
 			add_json_map( name, daw::move( mapping_functions ) );
 		}
 
@@ -343,6 +885,14 @@ namespace daw::json {
 				  set_function( obj, value.get_array( ) );
 			  };
 
+			mapping_functions.parse_function =
+			  [set_function]( Derived &obj, impl::text::text_range_t &rng ) mutable {
+				  set_function( obj, impl::text::array_source_t{ &rng } );
+			  };
+
+			mapping_functions.validate_function = &impl::validate_value<
+			  std::decay_t<std::invoke_result_t<GetFunction, Derived const &>>>;
+
 			add_json_map( name, daw::move( mapping_functions ) );
 		}
 
@@ -360,6 +910,14 @@ namespace daw::json {
 				  set_function( obj, value.get_array( ) );
 			  };
 
+			mapping_functions.parse_function =
+			  [set_function]( Derived &obj, impl::text::text_range_t &rng ) mutable {
+				  set_function( obj, impl::text::array_source_t{ &rng } );
+			  };
+
+			mapping_functions.validate_function = &impl::validate_value<
+			  std::decay_t<std::invoke_result_t<GetFunction, Derived const &>>>;
+
 			add_json_map( name, daw::move( mapping_functions ) );
 		}
 
@@ -377,6 +935,14 @@ namespace daw::json {
 				  set_function( obj, value.get_array( ) );
 			  };
 
+			mapping_functions.parse_function =
+			  [set_function]( Derived &obj, impl::text::text_range_t &rng ) mutable {
+				  set_function( obj, impl::text::array_source_t{ &rng } );
+			  };
+
+			mapping_functions.validate_function = &impl::validate_value<
+			  std::decay_t<std::invoke_result_t<GetFunction, Derived const &>>>;
+
 			add_json_map( name, daw::move( mapping_functions ) );
 		}
 
@@ -396,6 +962,14 @@ namespace daw::json {
 				  set_function( obj, value.get_object( ) );
 			  };
 
+			mapping_functions.parse_function =
+			  [set_function]( Derived &obj, impl::text::text_range_t &rng ) mutable {
+				  set_function( obj, impl::text::object_source_t{ &rng } );
+			  };
+
+			mapping_functions.validate_function = &impl::validate_value<
+			  std::decay_t<std::invoke_result_t<GetFunction, Derived const &>>>;
+
 			add_json_map( name, daw::move( mapping_functions ) );
 		}
 
@@ -406,54 +980,216 @@ namespace daw::json {
 		json_link &operator=( json_link const & ) = default;
 		json_link &operator=( json_link && ) = default;
 
-		std::string to_json_string( ) const {
-			check_json_maps( );
-			std::stringstream ss;
-			bool is_first = true;
-			ss << "{";
-			for( auto const &kv : get_json_maps( ) ) {
-				if( is_first ) {
-					is_first = false;
-				} else {
-					ss << ",";
+		void append_json_string( std::string &json_text ) const {
+			if constexpr( impl::has_json_members_v<Derived> ) {
+				json_text += '{';
+				std::apply(
+				  [&]( auto const &... member ) {
+					  bool is_first = true;
+					  ( ( json_text += is_first ? "" : ",",
+					      json_text += impl::to_json_string( member.name ),
+					      json_text += ':',
+					      impl::append_member_value(
+					        json_text, this_as_derived( ).*member.member ),
+					      is_first = false ),
+					    ... );
+				  },
+				  Derived::json_members( ) );
+				json_text += '}';
+			} else {
+				bool is_first = true;
+				json_text += '{';
+				for( auto const &kv : get_json_maps( ) ) {
+					if( is_first ) {
+						is_first = false;
+					} else {
+						json_text += ',';
+					}
+					json_text += impl::to_json_string( kv.first );
+					json_text += ':';
+					json_text += kv.second.serialize_function( this_as_derived( ) );
 				}
-				ss << impl::to_json_string( kv.first );
-				ss << ":";
-				ss << kv.second.serialize_function( this_as_derived( ) );
+				json_text += '}';
 			}
-			ss << "}";
-			return ss.str( );
+		}
+
+		std::string to_json_string( ) const {
+			std::string result;
+			append_json_string( result );
+			return result;
 		}
 
 		static bool has_key( daw::string_view name ) {
-			return get_json_maps( ).count( static_cast<std::string>( name ) ) > 0;
+			if constexpr( impl::has_json_members_v<Derived> ) {
+				return find_table_member( name, []( auto const & ) {} );
+			} else {
+				return find_json_map( name ) != nullptr;
+			}
 		}
 
 		static Derived from_json_value( json_value_t const &json_value ) {
 			auto const &obj = json_value.get_object( );
 
 			Derived result;
+			if constexpr( impl::has_json_members_v<Derived> ) {
+				std::apply(
+				  [&]( auto const &... member ) {
+					  ( set_member_from_object( result, obj, member ), ... );
+				  },
+				  Derived::json_members( ) );
+				return result;
+			} else {
+				for( auto const &linked_item : get_json_maps( ) ) {
+					auto const it = obj.find( linked_item.first );
+					// TODO: when optional
+
+					try {
+						linked_item.second.deserialize_function( result, it->second );
+					} catch( std::exception const &ex ) {
+						std::string msg = "Exception while deserializing member '" +
+						                  linked_item.first + "': " + ex.what( );
+						throw std::runtime_error( msg );
+					}
+				}
+				return result;
+			}
+		}
 
-			for( auto const &linked_item : get_json_maps( ) ) {
-				auto const it = obj.find( linked_item.first );
-				// TODO: when optional
+		/// @brief Decode the json object at the front of rng straight into
+		/// result, without building json_value_t nodes.  Members that are not
+		/// mapped are skipped and mapped members missing from the text are left
+		/// untouched
+		static void from_json_text( Derived &result,
+		                            impl::text::text_range_t &rng ) {
+			if constexpr( impl::has_json_members_v<Derived> ) {
+				impl::text::parse_object(
+				  rng, [&]( daw::string_view name, bool has_escape,
+				            impl::text::text_range_t &value_rng ) {
+					  std::string unescaped{ };
+					  if( has_escape ) {
+						  unescaped = unescaped_name( name );
+						  name = daw::string_view( unescaped.data( ), unescaped.size( ) );
+					  }
+					  bool const is_mapped =
+					    find_table_member( name, [&]( auto const &member ) {
+						    parse_member( result, value_rng, member );
+					    } );
+					  if( not is_mapped ) {
+						  impl::text::skip_value( value_rng );
+					  }
+				  } );
+			} else {
+				check_json_maps( );
+				impl::text::parse_object(
+				  rng, [&]( daw::string_view name, bool has_escape,
+				            impl::text::text_range_t &value_rng ) {
+					  std::string unescaped{ };
+					  if( has_escape ) {
+						  unescaped = unescaped_name( name );
+						  name = daw::string_view( unescaped.data( ), unescaped.size( ) );
+					  }
+					  auto const mapping = find_json_map( name );
+					  if( not mapping ) {
+						  impl::text::skip_value( value_rng );
+						  return;
+					  }
+					  try {
+						  mapping->parse_function( result, value_rng );
+					  } catch( std::exception const &ex ) {
+						  std::string msg = "Exception while deserializing member '" +
+						                    std::string( name.data( ), name.size( ) ) +
+						                    "': " + ex.what( );
+						  throw std::runtime_error( msg );
+					  }
+				  } );
+			}
+		}
 
-				try {
-					linked_item.second.deserialize_function( result, it->second );
-				} catch( std::exception const &ex ) {
-					std::string msg = "Exception while deserializing member '" +
-					                  linked_item.first + "': " + ex.what( );
-					throw std::runtime_error( msg );
-				}
+		/// @brief Decode json_string into an existing object, overwriting its
+		/// members in place.  Strings and vectors reuse the capacity they already
+		/// have, so decoding the same kind of message repeatedly into one object
+		/// stops allocating once the buffers are large enough.  Members missing
+		/// from json_string keep their previous values
+		static void decode_into( Derived &result, daw::string_view json_string ) {
+			auto rng = impl::text::make_text_range( json_string );
+			impl::text::skip_ws( rng );
+			daw::exception::precondition_check(
+			  not rng.empty( ) and rng.front( ) == '{',
+			  "Only JsonObjects can be deserialized" );
+			from_json_text( result, rng );
+			impl::text::skip_ws( rng );
+			daw::exception::precondition_check(
+			  rng.empty( ), "Unexpected data after end of JsonObject" );
+		}
+
+		/// @brief Check the json object at the front of rng against the mapping
+		/// without decoding it.  Every mapped member must be present and hold a
+		/// value of the mapped type, and integers must fit their members.
+		/// Members that are not mapped only need to be well formed json
+		static bool validate_text( impl::text::text_range_t &rng ) {
+			if constexpr( impl::has_json_members_v<Derived> ) {
+				constexpr auto member_count =
+				  std::tuple_size_v<decltype( Derived::json_members( ) )>;
+				impl::seen_members_t seen( member_count );
+				bool const is_valid = impl::text::check_object(
+				  rng, [&]( daw::string_view name, bool has_escape,
+				            impl::text::text_range_t &value_rng ) {
+					  std::string unescaped{ };
+					  if( has_escape and not unescape_name( name, unescaped ) ) {
+						  return false;
+					  }
+					  auto const index = get_member_table_index( ).find( name );
+					  if( not index ) {
+						  return impl::text::check_value( value_rng );
+					  }
+					  bool is_member_valid = false;
+					  impl::visit_json_member(
+					    Derived::json_members( ), *index, [&]( auto const &member ) {
+						    using member_t =
+						      typename std::decay_t<decltype( member )>::member_t;
+						    is_member_valid = impl::validate_value<member_t>( value_rng );
+					    } );
+					  seen.set( *index );
+					  return is_member_valid;
+				  } );
+				return is_valid and seen.all( );
+			} else {
+				auto const &index = get_member_index( );
+				impl::seen_members_t seen( index.size( ) );
+				bool const is_valid = impl::text::check_object(
+				  rng, [&]( daw::string_view name, bool has_escape,
+				            impl::text::text_range_t &value_rng ) {
+					  std::string unescaped{ };
+					  if( has_escape and not unescape_name( name, unescaped ) ) {
+						  return false;
+					  }
+					  auto const mapping = index.find( name );
+					  if( not mapping ) {
+						  return impl::text::check_value( value_rng );
+					  }
+					  seen.set( ( *mapping )->member_number );
+					  return ( *mapping )->validate_function( value_rng );
+				  } );
+				return is_valid and seen.all( );
 			}
-			return result;
+		}
+
+		/// @brief Accept or reject json_text as an encoding of Derived in one
+		/// pass, without decoding it or throwing on bad input.  See validate_text
+		static bool is_valid_json( daw::string_view json_text ) {
+			auto rng = impl::text::make_text_range( json_text );
+			impl::text::skip_ws( rng );
+			if( not validate_text( rng ) ) {
+				return false;
+			}
+			impl::text::skip_ws( rng );
+			return rng.empty( );
 		}
 
 		static Derived from_json_string( daw::string_view json_string ) {
-			auto const json_value = parse_json( json_string );
-			daw::exception::precondition_check(
-			  json_value.is_object( ), "Only JsonObjects can be deserialized" );
-			return from_json_value( json_value );
+			Derived result;
+			decode_into( result, json_string );
+			return result;
 		}
 
 		static auto &get_json_maps( ) {
@@ -461,15 +1197,35 @@ namespace daw::json {
 			return get_map( );
 		}
 
+		/// @brief The mapping registered for name, or nullptr when name is not
+		/// mapped.  Looks the name up in a perfect hash and does not allocate
+		static mapping_functions_t const *find_json_map( daw::string_view name ) {
+			check_json_maps( );
+			auto const mapping = get_member_index( ).find( name );
+			return mapping ? *mapping : nullptr;
+		}
+
+		template<typename D>
+		static void from_json_object( D &json_link_obj,
+		                              impl::text::object_source_t const &obj ) {
+			D::from_json_text( json_link_obj, *obj.range );
+		}
+
 		template<typename D>
 		static void from_json_object( D &json_link_obj,
 		                              json_object_value const &obj ) {
-			for( auto const &kv : obj ) {
-				auto const value_name = kv.first.to_string( );
-				if( json_link_obj.has_key( value_name ) ) {
-					auto const mapped_functions =
-					  json_link_obj.get_json_maps( )[value_name];
-					mapped_functions.deserialize_function( json_link_obj, kv.second );
+			if constexpr( impl::has_json_members_v<D> ) {
+				std::apply(
+				  [&]( auto const &... member ) {
+					  ( set_member_from_object( json_link_obj, obj, member ), ... );
+				  },
+				  D::json_members( ) );
+			} else {
+				for( auto const &kv : obj ) {
+					auto const mapping = D::find_json_map( to_string_view( kv.first ) );
+					if( mapping ) {
+						mapping->deserialize_function( json_link_obj, kv.second );
+					}
 				}
 			}
 		}
@@ -484,12 +1240,10 @@ namespace daw::json {
 			}
 			throw std::runtime_error( "file not found" );
 		}
-		auto in_file = daw::filesystem::memory_mapped_file_t<char>(
-		  std::string( file_name.data( ), file_name.size( ) ).c_str( ) );
+		auto const in_file = json_file_t( file_name );
 		daw::exception::precondition_check( in_file, "Could not open file" );
 
-		auto const json_value = parse_json( in_file.begin( ), in_file.end( ) );
-		return Derived::from_json_value( json_value );
+		return Derived::from_json_string( in_file.to_string_view( ) );
 	}
 
 	template<typename Derived, typename = std::enable_if<
@@ -517,9 +1271,26 @@ namespace daw::json {
 
 	template<typename Derived, typename = std::enable_if<
 	                             std::is_base_of_v<json_link<Derived>, Derived>>>
-	std::vector<Derived> array_from_string( daw::string_view data,
-	                                        bool use_default_on_error ) {
-		return array_from_json_value<Derived>( parse_json( data ) );
+	std::vector<Derived> array_from_string( daw::string_view data, bool ) {
+		std::vector<Derived> result;
+		auto rng = impl::text::make_text_range( data );
+		impl::text::skip_ws( rng );
+		daw::exception::precondition_check(
+		  not rng.empty( ) and rng.front( ) == '[',
+		  "Value expected to be json array" );
+		impl::text::parse_array( rng, [&result]( auto &element_rng ) {
+			try {
+				Derived item;
+				Derived::from_json_text( item, element_rng );
+				result.push_back( daw::move( item ) );
+			} catch( std::exception const &ex ) {
+				using namespace std::string_literals;
+				std::string msg =
+				  "Exception while deserializing json value: "s + ex.what( );
+				throw std::runtime_error( msg );
+			}
+		} );
+		return result;
 	}
 
 	template<typename Derived, typename = std::enable_if<
@@ -532,21 +1303,111 @@ namespace daw::json {
 			}
 			throw std::runtime_error( "file not found" );
 		}
-		auto in_file = daw::filesystem::memory_mapped_file_t<char>(
-		  std::string( file_name.data( ), file_name.size( ) ).c_str( ) );
+		auto const in_file = json_file_t( file_name );
 
 		daw::exception::precondition_check( in_file, "Could not open file" );
-		json_value_t json_value;
 		try {
-			json_value = parse_json( in_file.begin( ), in_file.end( ) );
+			return array_from_string<Derived>( in_file.to_string_view( ),
+			                                   use_default_on_error );
 		} catch( std::exception const &ex ) {
-			std::string msg = "Exception while parsing json file '" +
-			                  static_cast<std::string>( file_name ) +
-			                  "': " + ex.what( );
+			std::string msg =
+			  "Exception while deserializing json array value from file '" +
+			  static_cast<std::string>( file_name ) + "': " + ex.what( );
 			throw std::runtime_error( msg );
 		}
+	}
+
+	namespace impl {
+		template<typename Derived, typename DecodeFunction>
+		std::vector<Derived> decode_elements_parallel( size_t element_count,
+		                                               size_t thread_count,
+		                                               DecodeFunction decode ) {
+			std::vector<Derived> result( element_count );
+			parallel_for_chunks(
+			  element_count, parallel_chunk_size( element_count, thread_count ),
+			  thread_count, [&]( size_t first, size_t last, size_t ) {
+				  for( auto n = first; n < last; ++n ) {
+					  try {
+						  decode( result[n], n );
+					  } catch( std::exception const &ex ) {
+						  std::string msg = "Exception while deserializing json array "
+						                    "element " +
+						                    std::to_string( n ) + ": " + ex.what( );
+						  throw std::runtime_error( msg );
+					  }
+				  }
+			  } );
+			return result;
+		}
+	} // namespace impl
+
+	/// @brief Deserialize the elements of a json array concurrently.  Each
+	/// element is decoded into its own pre-sized slot of the result, so the
+	/// order matches the source
+	/// @param json_value array of json objects
+	/// @param thread_count maximum number of threads to use, 0 for all cores
+	/// @throws std::runtime_error naming the lowest index of an element that
+	/// failed to decode, as the sequential decoder would.  The remaining
+	/// chunks are abandoned
+	template<typename Derived, typename = std::enable_if<
+	                             std::is_base_of_v<json_link<Derived>, Derived>>>
+	std::vector<Derived>
+	array_from_json_value_parallel( json_value_t const &json_value,
+	                                size_t thread_count = 0 ) {
+		daw::exception::precondition_check(
+		  json_value.is_array( ), "Value expected to be json array.  It was as " +
+		                            daw::json::to_string( json_value.type( ) ) );
+		auto const &values = json_value.get_array( );
+		return impl::decode_elements_parallel<Derived>(
+		  values.size( ), thread_count, [&values]( Derived &dest, size_t n ) {
+			  daw::exception::precondition_check( values[n].is_object( ),
+			                                      "Expected a json object" );
+			  dest = Derived::from_json_value( values[n] );
+		  } );
+	}
+
+	/// @brief Deserialize a json array of objects concurrently.  One quick
+	/// sequential pass finds where each element starts without decoding it,
+	/// then the elements are decoded in parallel straight from the text
+	/// @param data json text of an array of objects
+	/// @param thread_count maximum number of threads to use, 0 for all cores
+	template<typename Derived, typename = std::enable_if<
+	                             std::is_base_of_v<json_link<Derived>, Derived>>>
+	std::vector<Derived> array_from_string_parallel( daw::string_view data,
+	                                                 size_t thread_count = 0 ) {
+		auto rng = impl::text::make_text_range( data );
+		impl::text::skip_ws( rng );
+		daw::exception::precondition_check(
+		  not rng.empty( ) and rng.front( ) == '[',
+		  "Value expected to be json array" );
+		std::vector<impl::text::text_range_t> elements{ };
+		impl::text::parse_array( rng, [&elements]( auto &element_rng ) {
+			auto const first = element_rng.first;
+			impl::text::skip_value( element_rng );
+			elements.push_back(
+			  impl::text::text_range_t{ first, element_rng.first } );
+		} );
+		return impl::decode_elements_parallel<Derived>(
+		  elements.size( ), thread_count, [&elements]( Derived &dest, size_t n ) {
+			  auto element_rng = elements[n];
+			  Derived::from_json_text( dest, element_rng );
+		  } );
+	}
+
+	/// @brief Deserialize a file containing a json array of objects
+	/// concurrently.  See array_from_string_parallel
+	template<typename Derived, typename = std::enable_if<
+	                             std::is_base_of_v<json_link<Derived>, Derived>>>
+	std::vector<Derived> array_from_file_parallel( daw::string_view file_name,
+	                                               size_t thread_count = 0 ) {
+		if( not boost::filesystem::exists( file_name.data( ) ) ) {
+			throw std::runtime_error( "file not found" );
+		}
+		auto const in_file = json_file_t( file_name );
+		daw::exception::precondition_check( in_file, "Could not open file" );
 		try {
-			return array_from_json_value<Derived>( json_value, use_default_on_error );
+			return array_from_string_parallel<Derived>( in_file.to_string_view( ),
+			                                            thread_count );
 		} catch( std::exception const &ex ) {
 			std::string msg =
 			  "Exception while deserializing json array value from file '" +
@@ -558,20 +1419,65 @@ namespace daw::json {
 	template<typename Derived, typename = std::enable_if<
 	                             std::is_base_of_v<json_link<Derived>, Derived>>>
 	Derived from_file( daw::string_view file_name ) {
-		auto in_file = daw::filesystem::memory_mapped_file_t<char>(
-		  std::string( file_name.data( ), file_name.size( ) ).c_str( ) );
+		auto const in_file = json_file_t( file_name );
 
 		daw::exception::precondition_check( in_file, "Could not open file" );
 
-		auto const json_value = parse_json( in_file.begin( ), in_file.end( ) );
-		return Derived::from_json_value( json_value );
+		return Derived::from_json_string( in_file.to_string_view( ) );
 	}
 
+	/// @brief Serialize an array of json_link objects.  Large arrays are split
+	/// into chunks that are serialized concurrently and joined in order
+	/// @param values objects to serialize
+	/// @param thread_count maximum number of threads to use, 0 for all cores
+	template<typename Derived, typename = std::enable_if<
+	                             std::is_base_of_v<json_link<Derived>, Derived>>>
+	std::string array_to_json_string( std::vector<Derived> const &values,
+	                                  size_t thread_count = 0 ) {
+		return impl::impl::to_json_array_parallel(
+		  values,
+		  []( std::string &json_text, Derived const &value ) {
+			  value.append_json_string( json_text );
+		  },
+		  thread_count );
+	}
+
+	/// @brief Serialize an array of json_link objects to a stream, writing the
+	/// chunk buffers in order without joining them first
+	/// @param os output stream
+	/// @param values objects to serialize
+	/// @param thread_count maximum number of threads to use, 0 for all cores
+	template<typename Derived, typename = std::enable_if<
+	                             std::is_base_of_v<json_link<Derived>, Derived>>>
+	void array_to_json_stream( std::ostream &os,
+	                           std::vector<Derived> const &values,
+	                           size_t thread_count = 0 ) {
+		impl::impl::to_json_array_parallel(
+		  os, values,
+		  []( std::string &json_text, Derived const &value ) {
+			  value.append_json_string( json_text );
+		  },
+		  thread_count );
+	}
+
+	/// @brief Serialize a json array value, splitting large arrays into chunks
+	/// that are serialized concurrently and joined in order
+	/// @param values array to serialize
+	/// @param thread_count maximum number of threads to use, 0 for all cores
+	std::string array_to_json_string( json_array_value const &values,
+	                                  size_t thread_count = 0 );
+
+	void array_to_json_stream( std::ostream &os, json_array_value const &values,
+	                           size_t thread_count = 0 );
+
+	/// @brief Write obj as json to file_name
+	/// @param overwrite replace an existing file, otherwise throw when it exists
+	/// @param compress write the file gzip compressed.  The from_file family
+	/// detects compressed files when reading
 	template<typename Derived>
 	void to_file( daw::string_view file_name, json_link<Derived> const &obj,
-	              bool overwrite ) {
-
-		// obj.to_file( file_name, overwrite );
+	              bool overwrite, bool compress = false ) {
+		write_json_file( file_name, obj.to_json_string( ), overwrite, compress );
 	}
 
 	template<typename Derived>
@@ -582,9 +1488,9 @@ namespace daw::json {
 
 	template<typename Derived>
 	std::istream &operator>>( std::istream &is, json_link<Derived> &data ) {
-		auto const str = std::string{ std::istreambuf_iterator<char>{ is },
-		                              std::istreambuf_iterator<char>{} };
-		data = Derived::from_json_value( parse_json( str ) );
+		json_block_source_t source( is );
+		auto const str = read_all( source );
+		static_cast<Derived &>( data ) = Derived::from_json_string( str );
 		return is;
 	}
 } // namespace daw::json
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "daw_json.h"
+#include "daw_json_file.h"
 #include "daw_json_parser.h"
 #include "daw_value_to_json.h"
 
@@ -205,15 +206,13 @@ namespace daw::json {
 
 	template<typename Derived>
 	void JsonLink<Derived>::from_json_file( daw::string_view filename ) {
-		std::ifstream in_file;
-		in_file.open( filename.data( ) );
+		// Plain files are memory mapped and parsed in place without a copy,
+		// gzip files are inflated into memory first
+		auto const in_file = json_file_t( filename );
 		if( !in_file ) {
 			throw std::runtime_error( "Could not open file" );
 		}
-		std::string const data{ std::istreambuf_iterator<char>{ in_file },
-		                        std::istreambuf_iterator<char>{} };
-		in_file.close( );
-		from_json_string( data );
+		from_json_string( in_file.to_string_view( ) );
 	}
 
 	template<typename Derived>
@@ -822,7 +821,7 @@ namespace daw::json {
 			}
 			throw std::runtime_error( "file not found" );
 		}
-		result.from_file( file_name );
+		result.from_json_file( file_name );
 		return result;
 	}
 
@@ -854,15 +853,12 @@ namespace daw::json {
 			}
 			throw std::runtime_error( "file not found" );
 		}
-		std::ifstream in_file;
-		in_file.open( file_name.data( ) );
+		auto const in_file = json_file_t( file_name );
 		if( !in_file ) {
 			throw std::runtime_error( "Could not open file" );
 		}
-		return array_from_json_string<Derived>(
-		  std::string{ std::istreambuf_iterator<char>{ in_file },
-		               std::istreambuf_iterator<char>{} },
-		  use_default_on_error );
+		return array_from_json_string<Derived>( in_file.to_string_view( ),
+		                                        use_default_on_error );
 	}
 
 	template<typename Derived, typename = std::enable_if<
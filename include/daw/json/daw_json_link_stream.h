@@ -0,0 +1,186 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include "daw_json_file.h"
+#include "daw_json_link.h"
+#include "daw_json_text_parser.h"
+
+#include <daw/daw_exception.h>
+#include <daw/daw_move.h>
+#include <daw/daw_string_view.h>
+
+#include <boost/filesystem.hpp>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace daw::json {
+	/// @brief Single pass iterator over the elements of a json array of
+	/// objects.  Each increment decodes the next element from the text, so
+	/// only one Derived exists at a time
+	template<typename Derived>
+	class json_array_iterator {
+		impl::text::text_range_t m_range{ nullptr, nullptr };
+		Derived m_value{ };
+		size_t m_index = 0;
+		bool m_at_end = true;
+
+		void decode_current( ) {
+			try {
+				m_value = Derived{ };
+				Derived::from_json_text( m_value, m_range );
+			} catch( std::exception const &ex ) {
+				std::string msg = "Exception while deserializing json array element " +
+				                  std::to_string( m_index ) + ": " + ex.what( );
+				throw std::runtime_error( msg );
+			}
+		}
+
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = Derived;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Derived const *;
+		using reference = Derived const &;
+
+		/// @brief The end iterator
+		json_array_iterator( ) = default;
+
+		/// @param json_text text starting with the array, leading whitespace is
+		/// allowed
+		explicit json_array_iterator( daw::string_view json_text )
+		  : m_range( impl::text::make_text_range( json_text ) ) {
+
+			impl::text::skip_ws( m_range );
+			daw::exception::precondition_check(
+			  not m_range.empty( ) and m_range.front( ) == '[',
+			  "Value expected to be json array" );
+			impl::text::expect( m_range, '[' );
+			impl::text::skip_ws( m_range );
+			if( impl::text::consume_if( m_range, ']' ) ) {
+				return;
+			}
+			m_at_end = false;
+			decode_current( );
+		}
+
+		reference operator*( ) const noexcept {
+			return m_value;
+		}
+
+		pointer operator->( ) const noexcept {
+			return &m_value;
+		}
+
+		/// @brief Move the current element out instead of copying it
+		Derived take( ) {
+			return daw::move( m_value );
+		}
+
+		/// @brief Position of the current element in the array
+		size_t index( ) const noexcept {
+			return m_index;
+		}
+
+		json_array_iterator &operator++( ) {
+			impl::text::skip_ws( m_range );
+			if( impl::text::consume_if( m_range, ',' ) ) {
+				impl::text::skip_ws( m_range );
+				++m_index;
+				decode_current( );
+				return *this;
+			}
+			impl::text::expect( m_range, ']' );
+			m_at_end = true;
+			return *this;
+		}
+
+		friend bool operator==( json_array_iterator const &lhs,
+		                        json_array_iterator const &rhs ) noexcept {
+			if( lhs.m_at_end or rhs.m_at_end ) {
+				return lhs.m_at_end == rhs.m_at_end;
+			}
+			return lhs.m_range.first == rhs.m_range.first;
+		}
+
+		friend bool operator!=( json_array_iterator const &lhs,
+		                        json_array_iterator const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+	}; // json_array_iterator
+
+	/// @brief Range over the elements of a json array of objects stored in a
+	/// file.  Plain files are memory mapped and walked in place, so memory use
+	/// is the pages being read plus one Derived.  Gzip files are inflated into
+	/// memory first
+	template<typename Derived>
+	class json_array_file_range {
+		json_file_t m_file;
+
+	public:
+		using iterator = json_array_iterator<Derived>;
+
+		explicit json_array_file_range( daw::string_view file_name )
+		  : m_file( file_name ) {
+
+			daw::exception::precondition_check( m_file, "Could not open file" );
+		}
+
+		/// @brief Start decoding from the first element.  Each call starts over
+		iterator begin( ) const {
+			return iterator( m_file.to_string_view( ) );
+		}
+
+		iterator end( ) const noexcept {
+			return iterator( );
+		}
+	}; // json_array_file_range
+
+	template<typename Derived, typename = std::enable_if<
+	                             std::is_base_of_v<json_link<Derived>, Derived>>>
+	json_array_file_range<Derived>
+	array_range_from_file( daw::string_view file_name ) {
+		if( not boost::filesystem::exists( file_name.data( ) ) ) {
+			throw std::runtime_error( "file not found" );
+		}
+		return json_array_file_range<Derived>( file_name );
+	}
+
+	/// @brief Decode the array of objects in a file batch_size elements at a
+	/// time, calling func( std::vector<Derived> & ) with each batch.  The same
+	/// vector is reused for every batch
+	/// @param file_name json file containing an array of objects
+	/// @param batch_size maximum number of elements per call to func
+	/// @param func callable taking a std::vector<Derived> &
+	template<typename Derived, typename Function,
+	         typename = std::enable_if<
+	           std::is_base_of_v<json_link<Derived>, Derived>>>
+	void array_from_file_batched( daw::string_view file_name, size_t batch_size,
+	                              Function func ) {
+		daw::exception::precondition_check( batch_size > 0,
+		                                    "batch_size must be greater than 0" );
+		auto const range = array_range_from_file<Derived>( file_name );
+		std::vector<Derived> batch{ };
+		batch.reserve( batch_size );
+		for( auto it = range.begin( ); it != range.end( ); ++it ) {
+			batch.push_back( it.take( ) );
+			if( batch.size( ) == batch_size ) {
+				func( batch );
+				batch.clear( );
+			}
+		}
+		if( not batch.empty( ) ) {
+			func( batch );
+		}
+	}
+} // namespace daw::json
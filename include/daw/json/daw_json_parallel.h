@@ -0,0 +1,112 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace daw::json::impl {
+	/// @brief Number of workers to use when the caller passes 0
+	inline size_t default_thread_count( ) noexcept {
+		auto const hw = static_cast<size_t>( std::thread::hardware_concurrency( ) );
+		return hw > 0 ? hw : 1;
+	}
+
+	/// @brief Pick a chunk size so that each worker gets several chunks to
+	/// balance uneven element costs, without making the chunks so small that
+	/// scheduling dominates
+	/// @param item_count number of items to be split
+	/// @param thread_count number of workers, 0 for default_thread_count( )
+	inline size_t parallel_chunk_size( size_t item_count,
+	                                   size_t thread_count ) noexcept {
+		constexpr size_t min_chunk_size = 1024;
+		constexpr size_t chunks_per_thread = 4;
+		if( thread_count == 0 ) {
+			thread_count = default_thread_count( );
+		}
+		auto const chunk_size = item_count / ( thread_count * chunks_per_thread );
+		return std::max( chunk_size, min_chunk_size );
+	}
+
+	/// @brief Split [0, item_count) into chunks and call
+	/// func( first, last, chunk_index ) for each of them on a bounded set of
+	/// worker threads.  The calling thread participates, so a single chunk runs
+	/// inline without starting any threads.  An exception thrown by func stops
+	/// the remaining chunks from starting.  Chunks are handed out in order, so
+	/// every chunk before a failing one has already started and runs to the
+	/// end, and the exception from the lowest failing chunk is rethrown.  The
+	/// error is the same one a sequential loop would report
+	/// @param item_count number of items to process
+	/// @param chunk_size maximum number of items handed to func at once
+	/// @param thread_count maximum number of workers, 0 for
+	/// default_thread_count( )
+	/// @param func callable with signature void( size_t, size_t, size_t )
+	template<typename Function>
+	void parallel_for_chunks( size_t item_count, size_t chunk_size,
+	                          size_t thread_count, Function func ) {
+		if( item_count == 0 ) {
+			return;
+		}
+		chunk_size = std::max( chunk_size, static_cast<size_t>( 1 ) );
+		auto const chunk_count = ( item_count + chunk_size - 1 ) / chunk_size;
+		if( thread_count == 0 ) {
+			thread_count = default_thread_count( );
+		}
+		thread_count = std::min( thread_count, chunk_count );
+
+		std::atomic<size_t> next_chunk{ 0 };
+		std::atomic<bool> has_error{ false };
+		std::exception_ptr first_error{ };
+		size_t first_error_chunk = chunk_count;
+		std::mutex error_mutex{ };
+
+		auto const worker = [&]( ) {
+			while( not has_error.load( std::memory_order_relaxed ) ) {
+				auto const chunk = next_chunk.fetch_add( 1, std::memory_order_relaxed );
+				if( chunk >= chunk_count ) {
+					return;
+				}
+				auto const first = chunk * chunk_size;
+				auto const last = std::min( first + chunk_size, item_count );
+				try {
+					func( first, last, chunk );
+				} catch( ... ) {
+					std::lock_guard<std::mutex> lock( error_mutex );
+					if( chunk < first_error_chunk ) {
+						first_error = std::current_exception( );
+						first_error_chunk = chunk;
+					}
+					has_error = true;
+				}
+			}
+		};
+
+		std::vector<std::thread> threads{ };
+		threads.reserve( thread_count - 1 );
+		try {
+			for( size_t n = 1; n < thread_count; ++n ) {
+				threads.emplace_back( worker );
+			}
+		} catch( ... ) {
+			// Could not start all the workers, run with the ones we have
+		}
+		worker( );
+		for( auto &t : threads ) {
+			t.join( );
+		}
+		if( first_error ) {
+			std::rethrow_exception( first_error );
+		}
+	}
+} // namespace daw::json::impl
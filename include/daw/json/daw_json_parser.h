@@ -12,6 +12,7 @@
 
 #include <daw/daw_string_view.h>
 
+#include <cstddef>
 #include <string>
 
 namespace daw::json {
@@ -33,4 +34,20 @@ namespace daw::json {
 	json_obj parse_json( char const *Begin, char const *End );
 
 	json_obj parse_json( daw::string_view json_text );
+
+	/// @brief Parse json_text like parse_json, but report malformed input
+	/// instead of returning a null value
+	/// @throws std::runtime_error with the parser's message when json_text is
+	/// not valid json
+	json_obj parse_json_checked( daw::string_view json_text );
+
+	/// @brief Parse a document whose top level value is a large array on up
+	/// to thread_count threads.  The text is cut into chunks, a few quick
+	/// parallel passes find where each chunk's first element boundary is, and
+	/// the elements between boundaries are parsed concurrently then joined in
+	/// order.  Anything else, or input too small to split, goes to parse_json
+	/// @param thread_count maximum number of threads to use, 0 for all cores
+	/// @return the same value as parse_json( json_text )
+	json_obj parse_json_parallel( daw::string_view json_text,
+	                              size_t thread_count = 0 );
 } // namespace daw::json
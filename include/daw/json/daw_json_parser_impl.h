@@ -9,6 +9,7 @@
 #pragma once
 
 #include "daw_json_parser_exception.h"
+#include "daw_json_text_parser.h"
 
 #include <daw/daw_exception.h>
 #include <daw/daw_parser_helper.h>
@@ -16,8 +17,182 @@
 #include <daw/daw_traits.h>
 
 #include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace daw::json {
+	/// @brief What a handler event may ask the parser to do next.  Handlers
+	/// whose event functions return void always proceed
+	enum class parse_control_t {
+		/// Carry on parsing
+		proceed,
+		/// From on_object_begin or on_array_begin, step over the contents
+		/// without reporting them, the matching end event is still reported.
+		/// From on_key, step over the member's value without reporting it.
+		/// Elsewhere the same as proceed
+		skip,
+		/// Stop parsing, json_parser returns the position after the token
+		stop
+	};
+} // namespace daw::json
 
 namespace daw::json::impl {
+	/// @brief Input whose tokens can be viewed in place instead of being
+	/// copied into the proxy's buffer
+	template<typename InputIterator>
+	inline constexpr bool is_contiguous_char_iterator_v =
+	  std::is_pointer_v<InputIterator> and
+	  std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIterator>>,
+	                 char>;
+
+	template<typename Handler, typename = void>
+	struct has_integer_value_event : std::false_type {};
+
+	template<typename Handler>
+	struct has_integer_value_event<
+	  Handler, std::void_t<decltype( std::declval<Handler &>( ).on_integer(
+	             std::declval<daw::string_view>( ),
+	             std::declval<json_value_t::integer_t>( ) ) )>>
+	  : std::true_type {};
+
+	template<typename Handler, typename = void>
+	struct has_real_value_event : std::false_type {};
+
+	template<typename Handler>
+	struct has_real_value_event<
+	  Handler, std::void_t<decltype( std::declval<Handler &>( ).on_real(
+	             std::declval<daw::string_view>( ),
+	             std::declval<json_value_t::real_t>( ) ) )>>
+	  : std::true_type {};
+
+	/// @brief Run one of the text parser's conversions, reporting its errors
+	/// as json_parser_exception like the rest of the v2 parser
+	template<typename Function>
+	auto convert_token( Function func ) {
+		try {
+			return func( );
+		} catch( std::runtime_error const &ex ) {
+			throw json_parser_exception( ex.what( ) );
+		}
+	}
+
+	/// @brief Sits between the parse functions and the handler passed to
+	/// json_parser.  It owns the scratch buffer that tokens are collected in,
+	/// so handlers only need the event functions, and forwards each event with
+	/// a direct call that the compiler can inline.  Each event returns what
+	/// the handler asked for, proceed when its function returns void, and the
+	/// answer to the latest event is kept in control
+	template<typename Handler>
+	struct parser_proxy_t {
+		Handler &handler;
+		std::string buffer{ };
+		std::string unescaped{ };
+		parse_control_t control = parse_control_t::proceed;
+
+		explicit parser_proxy_t( Handler &h )
+		  : handler( h ) {}
+
+		void push( char c ) {
+			buffer.push_back( c );
+		}
+
+		void clear_buffer( ) {
+			buffer.clear( );
+		}
+
+		bool is_stopped( ) const noexcept {
+			return control == parse_control_t::stop;
+		}
+
+		template<typename Event>
+		parse_control_t dispatch( Event event ) {
+			if constexpr( std::is_same_v<decltype( event( ) ), parse_control_t> ) {
+				control = event( );
+			} else {
+				event( );
+				control = parse_control_t::proceed;
+			}
+			return control;
+		}
+
+		parse_control_t on_object_begin( ) {
+			return dispatch( [&]( ) { return handler.on_object_begin( ); } );
+		}
+
+		parse_control_t on_object_end( ) {
+			return dispatch( [&]( ) { return handler.on_object_end( ); } );
+		}
+
+		parse_control_t on_array_begin( ) {
+			return dispatch( [&]( ) { return handler.on_array_begin( ); } );
+		}
+
+		parse_control_t on_array_end( ) {
+			return dispatch( [&]( ) { return handler.on_array_end( ); } );
+		}
+
+		/// @brief Strings without escapes are passed through untouched, the
+		/// rest are decoded into unescaped
+		daw::string_view unescape( daw::string_view raw, bool has_escape ) {
+			if( not has_escape ) {
+				return raw;
+			}
+			unescaped.clear( );
+			convert_token( [&]( ) {
+				text::unescape_string( raw, unescaped );
+				return 0;
+			} );
+			return daw::string_view( unescaped.data( ), unescaped.size( ) );
+		}
+
+		parse_control_t on_key( daw::string_view raw, bool has_escape ) {
+			auto const key = unescape( raw, has_escape );
+			return dispatch( [&]( ) { return handler.on_key( key ); } );
+		}
+
+		parse_control_t on_string( daw::string_view raw, bool has_escape ) {
+			auto const value = unescape( raw, has_escape );
+			return dispatch( [&]( ) { return handler.on_string( value ); } );
+		}
+
+		/// @brief Handlers that take the converted value as a second argument
+		/// receive it, the rest only get the text
+		parse_control_t on_integer( daw::string_view value ) {
+			if constexpr( has_integer_value_event<Handler>::value ) {
+				auto const number = convert_token( [value]( ) {
+					auto rng = text::make_text_range( value );
+					return text::parse_integer( rng );
+				} );
+				return dispatch(
+				  [&]( ) { return handler.on_integer( value, number ); } );
+			} else {
+				return dispatch( [&]( ) { return handler.on_integer( value ); } );
+			}
+		}
+
+		parse_control_t on_real( daw::string_view value ) {
+			if constexpr( has_real_value_event<Handler>::value ) {
+				auto const number = convert_token( [value]( ) {
+					auto rng = text::make_text_range( value );
+					return text::parse_real( rng );
+				} );
+				return dispatch( [&]( ) { return handler.on_real( value, number ); } );
+			} else {
+				return dispatch( [&]( ) { return handler.on_real( value ); } );
+			}
+		}
+
+		parse_control_t on_boolean( bool value ) {
+			return dispatch( [&]( ) { return handler.on_boolean( value ); } );
+		}
+
+		parse_control_t on_null( ) {
+			return dispatch( [&]( ) { return handler.on_null( ); } );
+		}
+	}; // parser_proxy_t
+
 	template<typename InputIterator, typename State, typename UnaryPredicate>
 	auto copy_until( InputIterator &first, InputIterator const &last,
 	                 State &state, UnaryPredicate pred ) {
@@ -28,17 +203,38 @@ namespace daw::json::impl {
 		return first;
 	}
 
+	/// @brief Copy c into state.buffer unless the input is viewed in place
+	template<typename InputIterator, typename State>
+	void collect( State &state, char c ) {
+		if constexpr( not is_contiguous_char_iterator_v<InputIterator> ) {
+			state.push( c );
+		}
+	}
+
+	/// @brief The text of the token that started at token_first, either in
+	/// place or from state.buffer
+	template<typename InputIterator, typename State>
+	daw::string_view token_view( InputIterator const &token_first,
+	                             InputIterator const &token_last,
+	                             State const &state ) {
+		if constexpr( is_contiguous_char_iterator_v<InputIterator> ) {
+			return daw::string_view(
+			  token_first, static_cast<size_t>( token_last - token_first ) );
+		} else {
+			return daw::string_view( state.buffer.data( ), state.buffer.size( ) );
+		}
+	}
+
 	template<typename InputIterator, typename State>
 	auto parse_integer( InputIterator &first, InputIterator const &last,
 	                    State &state ) {
 		if( first == last || !isdigit( *first ) ) {
-			throw json_parser_exception( "Expecting digits, found none '" +
-			                             state.buffer + "'" );
+			throw json_parser_exception( "Expecting digits, found none" );
 		}
-		state.push( *first );
+		collect<InputIterator>( state, *first );
 		++first;
 		while( first != last && isdigit( *first ) ) {
-			state.push( *first );
+			collect<InputIterator>( state, *first );
 			++first;
 		}
 		return first;
@@ -73,63 +269,93 @@ namespace daw::json::impl {
 		using namespace daw::parser;
 		// Assume that *first is in the set { '-', '0'->'9' }
 		state.clear_buffer( );
+		auto const number_first = first;
 
 		if( '-' == *first ) {
-			state.push( *first );
+			collect<InputIterator>( state, *first );
 			++first;
 		}
 		first = parse_integer( first, last, state );
 
 		if( first == last || !is_a( *first, '.', 'E', 'e' ) ) {
-			state.on_integer( state.buffer );
+			state.on_integer( token_view( number_first, first, state ) );
 			return first;
 		}
 		if( '.' == *first ) {
-			state.push( *first );
+			collect<InputIterator>( state, *first );
 			++first;
 			first = parse_integer( first, last, state );
 		}
 		if( first == last || !is_a( *first, 'e', 'E' ) ) {
-			state.on_real( state.buffer );
+			state.on_real( token_view( number_first, first, state ) );
 			return first;
 		}
-		state.push( *first ); // save { e, E }
+		collect<InputIterator>( state, *first ); // save { e, E }
 		++first;
-		if( is_a( *first, '-', '+' ) ) {
-			state.push( *first );
+		if( first != last && is_a( *first, '-', '+' ) ) {
+			collect<InputIterator>( state, *first );
 			++first;
 		}
 		first = parse_integer( first, last, state );
-		state.on_real( state.buffer );
+		state.on_real( token_view( number_first, first, state ) );
 		return first;
 	}
 
+	/// @brief Find the end of the string at first.  Contiguous input is
+	/// viewed in place, anything else is collected into state.buffer
+	/// @param has_escape set to true when the string holds a '\\'
+	/// @return the contents of the string, escapes still in place.  first is
+	/// left on the closing quote
 	template<typename InputIterator, typename State>
-	auto parse_string( InputIterator &first, InputIterator const &last,
-	                   State &state ) {
+	daw::string_view scan_string( InputIterator &first,
+	                              InputIterator const &last, State &state,
+	                              bool &has_escape ) {
 		// Assumes that *first == '"'
 		++first;
 		state.clear_buffer( );
-		bool in_slash = false;
-		while( first != last ) {
-			switch( *first ) {
-			case '"':
-				if( !in_slash ) {
-					state.on_string( state.buffer );
-					return std::next( first );
+		if constexpr( is_contiguous_char_iterator_v<InputIterator> ) {
+			auto const str_first = first;
+			auto const str_last = convert_token( [&]( ) {
+				return text::find_string_end( str_first, last, has_escape );
+			} );
+			first += str_last - str_first;
+			return token_view( str_first, first, state );
+		} else {
+			bool in_slash = false;
+			while( first != last ) {
+				if( in_slash ) {
+					in_slash = false;
+				} else if( *first == '"' ) {
+					return daw::string_view( state.buffer.data( ),
+					                         state.buffer.size( ) );
+				} else if( *first == '\\' ) {
+					in_slash = true;
+					has_escape = true;
 				}
-				break;
-			case '\\':
-				in_slash = true;
-				break;
-			default:
-				in_slash = false;
-				break;
+				state.push( *first );
+				++first;
 			}
-			state.push( *first );
-			++first;
+			throw json_parser_exception(
+			  "Unclosed string when end of input reached" );
 		}
-		throw json_parser_exception( "Unclosed string when end of input reached" );
+	}
+
+	template<typename InputIterator, typename State>
+	auto parse_string( InputIterator &first, InputIterator const &last,
+	                   State &state ) {
+		bool has_escape = false;
+		auto const raw = scan_string( first, last, state, has_escape );
+		state.on_string( raw, has_escape );
+		return std::next( first );
+	}
+
+	template<typename InputIterator, typename State>
+	auto parse_key( InputIterator &first, InputIterator const &last,
+	                State &state ) {
+		bool has_escape = false;
+		auto const raw = scan_string( first, last, state, has_escape );
+		state.on_key( raw, has_escape );
+		return std::next( first );
 	}
 
 	template<typename InputIterator, typename State>
@@ -176,6 +402,56 @@ namespace daw::json::impl {
 		return first;
 	}
 
+	/// @brief Step over the value at first without reporting it.  Contiguous
+	/// input uses the text parser's bracket balanced scan
+	template<typename InputIterator>
+	InputIterator skip_value( InputIterator &first, InputIterator const &last ) {
+		if constexpr( is_contiguous_char_iterator_v<InputIterator> ) {
+			auto rng = text::text_range_t{ first, last };
+			convert_token( [&rng]( ) {
+				text::skip_value( rng );
+				return 0;
+			} );
+			first += rng.first - first;
+			return first;
+		} else {
+			if( *first != '"' and *first != '{' and *first != '[' ) {
+				// Number or literal
+				while( first != last and not is_insignificant_ws( *first ) and
+				       *first != ',' and *first != ']' and *first != '}' ) {
+					++first;
+				}
+				return first;
+			}
+			size_t depth = 0;
+			bool in_string = false;
+			bool escaped = false;
+			while( first != last ) {
+				auto const c = *first;
+				++first;
+				if( escaped ) {
+					escaped = false;
+				} else if( in_string ) {
+					if( c == '\\' ) {
+						escaped = true;
+					} else if( c == '"' ) {
+						in_string = false;
+						if( depth == 0 ) {
+							return first;
+						}
+					}
+				} else if( c == '"' ) {
+					in_string = true;
+				} else if( c == '{' or c == '[' ) {
+					++depth;
+				} else if( ( c == '}' or c == ']' ) and --depth == 0 ) {
+					return first;
+				}
+			}
+			throw json_parser_exception( "Unexpected end of input in a value" );
+		}
+	}
+
 	template<typename InputIterator, typename State>
 	InputIterator parse_object( InputIterator &, InputIterator const &, State & );
 
@@ -231,11 +507,25 @@ namespace daw::json::impl {
 	InputIterator parse_array( InputIterator &first, InputIterator const &last,
 	                           State &state ) {
 		// Assume the *first == '['
-		state.on_array_begin( );
+		auto const control = state.on_array_begin( );
+		if( control == parse_control_t::stop ) {
+			return std::next( first );
+		} else if( control == parse_control_t::skip ) {
+			first = skip_value( first, last );
+			state.on_array_end( );
+			return first;
+		}
 		++first;
 		first = skip_whitespace( first, last );
+		if( first != last && *first == ']' ) {
+			state.on_array_end( );
+			return std::next( first );
+		}
 		while( first != last && *first != ']' ) {
 			first = parse_value( first, last, state );
+			if( state.is_stopped( ) ) {
+				return first;
+			}
 			first = skip_whitespace( first, last );
 			throw_at_end_of_stream(
 			  first, last, "Expected a closing ']' for array but found end" );
@@ -257,11 +547,29 @@ namespace daw::json::impl {
 	InputIterator parse_object( InputIterator &first, InputIterator const &last,
 	                            State &state ) {
 		// Assume the *first == '{'
-		state.on_object_begin( );
+		auto const control = state.on_object_begin( );
+		if( control == parse_control_t::stop ) {
+			return std::next( first );
+		} else if( control == parse_control_t::skip ) {
+			first = skip_value( first, last );
+			state.on_object_end( );
+			return first;
+		}
 		++first;
 		first = skip_whitespace( first, last );
+		if( first != last && *first == '}' ) {
+			state.on_object_end( );
+			return std::next( first );
+		}
 		while( first != last && *first != '}' ) {
-			first = parse_string( first, last, state );
+			if( *first != '"' ) {
+				throw json_parser_exception( "Expected a member name" );
+			}
+			first = parse_key( first, last, state );
+			if( state.is_stopped( ) ) {
+				return first;
+			}
+			auto const key_control = state.control;
 			first = skip_whitespace( first, last );
 			throw_at_end_of_stream( first, last,
 			                        "Expected member separator ':' but found end" );
@@ -269,7 +577,16 @@ namespace daw::json::impl {
 				throw json_parser_exception( "Unexpected character.  Expecting ':'" );
 			}
 			++first;
-			first = parse_value( first, last, state );
+			if( key_control == parse_control_t::skip ) {
+				first = skip_whitespace( first, last );
+				throw_at_end_of_stream( first, last, "Unexpected end of stream" );
+				first = skip_value( first, last );
+			} else {
+				first = parse_value( first, last, state );
+				if( state.is_stopped( ) ) {
+					return first;
+				}
+			}
 			first = skip_whitespace( first, last );
 			throw_at_end_of_stream(
 			  first, last,
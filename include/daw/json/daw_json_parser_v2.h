@@ -11,25 +11,64 @@
 #include "daw_json_parser_exception.h"
 #include "daw_json_parser_impl.h"
 
+#include <daw/daw_string_view.h>
+
 namespace daw::json {
+	/// @brief Handler with an empty body for every event.  Derive from it and
+	/// hide only the events of interest.
+	///
+	/// A handler passed to json_parser is any type with these members, called
+	/// directly on the concrete handler type without virtual dispatch:
+	///   on_object_begin( ), on_object_end( )
+	///   on_array_begin( ), on_array_end( )
+	///   on_key( daw::string_view )      member name of the current object
+	///   on_string( daw::string_view )   string value with escapes decoded
+	///   on_integer( daw::string_view )  text of an integer value
+	///   on_real( daw::string_view )     text of a real value
+	///   on_boolean( bool )
+	///   on_null( )
+	/// A handler may instead declare on_integer( daw::string_view, intmax_t )
+	/// or on_real( daw::string_view, double ) to also receive the converted
+	/// number.  When the input is a pointer to char, keys, strings without
+	/// escapes and numbers are views into the input and nothing is copied.
+	/// Otherwise the views refer to a buffer that is reused for the next
+	/// token, so they only live until the handler returns.  Member names are
+	/// always reported with on_key, never with on_string.
+	///
+	/// Any event may return a parse_control_t instead of void to skip a
+	/// subtree or stop the parse early
+	struct json_handler_base {
+		void on_object_begin( ) {}
+		void on_object_end( ) {}
+		void on_array_begin( ) {}
+		void on_array_end( ) {}
+		void on_key( daw::string_view ) {}
+		void on_string( daw::string_view ) {}
+		void on_integer( daw::string_view ) {}
+		void on_real( daw::string_view ) {}
+		void on_boolean( bool ) {}
+		void on_null( ) {}
+	}; // json_handler_base
+
+	/// @brief Parse the json in [first, last) and report each token to
+	/// handler.  The input may hold several top level values, including
+	/// scalars, separated by whitespace.  See json_handler_base for the events
+	/// a handler receives
+	/// @return last, or the position after the token whose event returned
+	/// parse_control_t::stop
 	template<typename InputIteratorFirst, typename InputIteratorLast,
-	         typename State>
-	void json_parser( InputIteratorFirst first, InputIteratorLast last,
-	                  State &state ) {
+	         typename Handler>
+	InputIteratorFirst json_parser( InputIteratorFirst first,
+	                                InputIteratorLast last, Handler &handler ) {
+		auto state = impl::parser_proxy_t<Handler>( handler );
 		first = impl::skip_whitespace( first, last );
 		while( first != last ) {
-			switch( *first ) {
-			case '{':
-				first = impl::parse_object( first, last, state );
-				break;
-			case '[':
-				first = impl::parse_array( first, last, state );
-				break;
-			default:
-				throw json_parser_exception(
-				  "Expected an array '[' or object '{' at start of json file" );
+			first = impl::parse_value( first, last, state );
+			if( state.is_stopped( ) ) {
+				return first;
 			}
 			first = impl::skip_whitespace( first, last );
 		}
+		return first;
 	}
 } // namespace daw::json
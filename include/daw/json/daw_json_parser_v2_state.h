@@ -25,18 +25,20 @@ namespace daw::json::state {
 		current_state_t_size
 	};
 
+	struct state_control_t;
+
 	struct state_t : daw::virtual_base<state_t> {
 		state_t( ) = default;
 
-		virtual void on_object_begin( );
-		virtual void on_object_end( );
-		virtual void on_array_begin( );
-		virtual void on_array_end( );
-		virtual void on_string( daw::string_view );
-		virtual void on_integer( daw::string_view );
-		virtual void on_real( daw::string_view );
-		virtual void on_boolean( bool );
-		virtual void on_null( );
+		virtual void on_object_begin( state_control_t & );
+		virtual void on_object_end( state_control_t & );
+		virtual void on_array_begin( state_control_t & );
+		virtual void on_array_end( state_control_t & );
+		virtual void on_string( state_control_t &, daw::string_view );
+		virtual void on_integer( state_control_t &, daw::string_view );
+		virtual void on_real( state_control_t &, daw::string_view );
+		virtual void on_boolean( state_control_t &, bool );
+		virtual void on_null( state_control_t & );
 		virtual std::string to_string( ) const = 0;
 	}; // state_t
 
@@ -51,8 +53,8 @@ namespace daw::json::state {
 
 		~state_in_object_name_t( ) override;
 		std::string to_string( ) const override;
-		void on_string( daw::string_view value ) override;
-		void on_object_end( ) override;
+		void on_string( state_control_t &control, daw::string_view value ) override;
+		void on_object_end( state_control_t &control ) override;
 	}; // state_in_object_name
 
 	struct state_in_object_value_t : public state_t {
@@ -67,14 +69,15 @@ namespace daw::json::state {
 		~state_in_object_value_t( ) override;
 
 		std::string to_string( ) const override;
-		void on_object_begin( ) override;
-		void on_array_begin( ) override;
-		void on_null( ) override;
-
-		void on_integer( daw::string_view value ) override;
-		void on_real( daw::string_view value ) override;
-		void on_string( daw::string_view value ) override;
-		void on_boolean( bool value ) override;
+		void on_object_begin( state_control_t &control ) override;
+		void on_array_begin( state_control_t &control ) override;
+		void on_null( state_control_t &control ) override;
+
+		void on_integer( state_control_t &control,
+		                 daw::string_view value ) override;
+		void on_real( state_control_t &control, daw::string_view value ) override;
+		void on_string( state_control_t &control, daw::string_view value ) override;
+		void on_boolean( state_control_t &control, bool value ) override;
 	}; // state_in_object_value_t
 
 	struct state_in_array_t : public state_t {
@@ -87,14 +90,15 @@ namespace daw::json::state {
 		~state_in_array_t( ) override;
 
 		std::string to_string( ) const override;
-		void on_object_begin( ) override;
-		void on_array_begin( ) override;
-		void on_array_end( ) override;
-		void on_null( ) override;
-		void on_integer( daw::string_view value ) override;
-		void on_real( daw::string_view value ) override;
-		void on_string( daw::string_view value ) override;
-		void on_boolean( bool value ) override;
+		void on_object_begin( state_control_t &control ) override;
+		void on_array_begin( state_control_t &control ) override;
+		void on_array_end( state_control_t &control ) override;
+		void on_null( state_control_t &control ) override;
+		void on_integer( state_control_t &control,
+		                 daw::string_view value ) override;
+		void on_real( state_control_t &control, daw::string_view value ) override;
+		void on_string( state_control_t &control, daw::string_view value ) override;
+		void on_boolean( state_control_t &control, bool value ) override;
 	}; // state_in_array_t
 
 	struct state_none_t : public state_t {
@@ -107,36 +111,42 @@ namespace daw::json::state {
 		~state_none_t( ) override;
 
 		std::string to_string( ) const override;
-		void on_object_begin( ) override;
-		void on_array_begin( ) override;
-		void on_null( ) override;
-		void on_integer( daw::string_view value ) override;
-		void on_real( daw::string_view value ) override;
-		void on_string( daw::string_view value ) override;
-		void on_boolean( bool value ) override;
+		void on_object_begin( state_control_t &control ) override;
+		void on_array_begin( state_control_t &control ) override;
+		void on_null( state_control_t &control ) override;
+		void on_integer( state_control_t &control,
+		                 daw::string_view value ) override;
+		void on_real( state_control_t &control, daw::string_view value ) override;
+		void on_string( state_control_t &control, daw::string_view value ) override;
+		void on_boolean( state_control_t &control, bool value ) override;
 	}; // state_none_t
 
-	state_t *get_state_fn( current_state_t s ) noexcept;
-	std::vector<state_t *> &state_stack( );
-	state_t &current_state( );
-	void push_and_set_next_state( current_state_t s );
-	void set_next_state( current_state_t s );
-	void pop_state( );
 	state_t *get_state_fn( current_state_t s ) noexcept;
 
+	/// @brief Drives the state machine for one parse.  The stack of states
+	/// lives here rather than in a global, so each parser owns its own and
+	/// several can run at once on different threads.  The state_t objects
+	/// themselves hold no data and are shared
 	struct state_control_t {
-		std::string buffer;
+		state_control_t( );
+
 		state_t const &current_state( ) const;
-		void push( char c );
-		void clear_buffer( );
-		void on_object_begin( ) const;
-		void on_object_end( ) const;
-		void on_array_begin( ) const;
-		void on_array_end( ) const;
-		void on_string( daw::string_view value ) const;
-		void on_integer( daw::string_view value ) const;
-		void on_real( daw::string_view value ) const;
-		void on_boolean( bool value ) const;
-		void on_null( ) const;
+		void push_and_set_next_state( current_state_t s );
+		void set_next_state( current_state_t s );
+		void pop_state( );
+
+		void on_object_begin( );
+		void on_object_end( );
+		void on_array_begin( );
+		void on_array_end( );
+		void on_key( daw::string_view key );
+		void on_string( daw::string_view value );
+		void on_integer( daw::string_view value );
+		void on_real( daw::string_view value );
+		void on_boolean( bool value );
+		void on_null( );
+
+	private:
+		std::vector<state_t *> m_state_stack;
 	};
 } // namespace daw::json::state
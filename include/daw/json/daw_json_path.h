@@ -0,0 +1,220 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include "daw_json_parser_impl.h"
+
+#include <daw/daw_string_view.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace daw::json {
+	/// @brief A compiled JSONPath expression from the subset
+	///   $             the root
+	///   .name ['name'] member of an object
+	///   .* [*]         any member or element
+	///   [n]            element n of an array
+	///   ..             recursive descent before any of the above
+	/// Matching is done one nesting level at a time, so a path can be
+	/// followed while the document is being parsed
+	class json_path_t {
+	public:
+		/// @brief Set of steps of the path matched so far, bit n is set when the
+		/// first n steps match
+		using step_mask_t = uint64_t;
+
+		/// @brief Longest supported path
+		static constexpr size_t max_steps = 63;
+
+	private:
+		enum class step_kind_t : uint8_t { name, index, wildcard };
+
+		struct step_t {
+			std::string name;
+			size_t index;
+			step_kind_t kind;
+			bool is_descendant;
+		};
+
+		std::vector<step_t> m_steps{ };
+
+		step_mask_t child_mask( step_mask_t parent, daw::string_view key,
+		                        size_t index, bool is_index ) const noexcept;
+
+	public:
+		/// @throws json_parser_exception when path is not in the subset
+		explicit json_path_t( daw::string_view path );
+
+		/// @brief Mask of the root value
+		static constexpr step_mask_t root_mask( ) noexcept {
+			return 1U;
+		}
+
+		/// @brief Mask of the member called key of an object with mask parent
+		step_mask_t member_mask( step_mask_t parent,
+		                         daw::string_view key ) const noexcept;
+
+		/// @brief Mask of element index of an array with mask parent
+		step_mask_t element_mask( step_mask_t parent,
+		                          size_t index ) const noexcept;
+
+		/// @brief true when a value with this mask is selected by the path
+		bool is_match( step_mask_t mask ) const noexcept;
+
+		size_t size( ) const noexcept;
+	}; // json_path_t
+
+	/// @brief json_parser handler that passes only the values selected by a
+	/// json_path_t on to handler, each as a complete value.  Everything else
+	/// is dropped as it is seen without being stored, and subtrees that
+	/// cannot contain a match are skipped by the parser.  A match nested
+	/// inside another match is delivered as part of the outer one.  Control
+	/// codes returned by handler are passed back to the parser
+	template<typename Handler>
+	class json_path_filter_t {
+		struct frame_t {
+			json_path_t::step_mask_t mask;
+			size_t next_index;
+			bool is_array;
+		};
+
+		json_path_t const *m_path;
+		impl::parser_proxy_t<Handler> m_out;
+		// Containers on the path to the current value that could still match
+		std::vector<frame_t> m_frames{ };
+		json_path_t::step_mask_t m_member_mask = 0;
+		// Open containers inside a subtree nothing can match in
+		size_t m_dead_depth = 0;
+		// Open containers inside the match being forwarded
+		size_t m_forward_depth = 0;
+		size_t m_match_count = 0;
+
+		/// @brief Work out the mask of a value that is starting
+		/// @return true when the value is a match and must be forwarded
+		bool begin_value( ) {
+			json_path_t::step_mask_t mask = json_path_t::root_mask( );
+			if( not m_frames.empty( ) ) {
+				auto &parent = m_frames.back( );
+				mask = parent.is_array
+				         ? m_path->element_mask( parent.mask, parent.next_index++ )
+				         : m_member_mask;
+			}
+			if( m_path->is_match( mask ) ) {
+				++m_match_count;
+				return true;
+			}
+			m_member_mask = mask;
+			return false;
+		}
+
+		template<typename Forward>
+		parse_control_t on_scalar( Forward forward ) {
+			if( m_dead_depth == 0 and ( m_forward_depth > 0 or begin_value( ) ) ) {
+				return forward( );
+			}
+			return parse_control_t::proceed;
+		}
+
+		template<typename Forward>
+		parse_control_t on_begin( bool is_array, Forward forward ) {
+			if( m_forward_depth > 0 ) {
+				++m_forward_depth;
+				return forward( );
+			} else if( m_dead_depth > 0 ) {
+				++m_dead_depth;
+			} else if( begin_value( ) ) {
+				m_forward_depth = 1;
+				return forward( );
+			} else if( m_member_mask == 0 ) {
+				// Nothing inside can match, have the parser step over it
+				m_dead_depth = 1;
+				return parse_control_t::skip;
+			} else {
+				m_frames.push_back( frame_t{ m_member_mask, 0, is_array } );
+			}
+			return parse_control_t::proceed;
+		}
+
+		template<typename Forward>
+		parse_control_t on_end( Forward forward ) {
+			if( m_forward_depth > 0 ) {
+				--m_forward_depth;
+				return forward( );
+			} else if( m_dead_depth > 0 ) {
+				--m_dead_depth;
+			} else {
+				m_frames.pop_back( );
+			}
+			return parse_control_t::proceed;
+		}
+
+	public:
+		/// @param path must outlive the filter
+		/// @param handler receives the events of every match
+		json_path_filter_t( json_path_t const &path, Handler &handler )
+		  : m_path( &path )
+		  , m_out( handler ) {}
+
+		parse_control_t on_object_begin( ) {
+			return on_begin( false, [&]( ) { return m_out.on_object_begin( ); } );
+		}
+
+		parse_control_t on_object_end( ) {
+			return on_end( [&]( ) { return m_out.on_object_end( ); } );
+		}
+
+		parse_control_t on_array_begin( ) {
+			return on_begin( true, [&]( ) { return m_out.on_array_begin( ); } );
+		}
+
+		parse_control_t on_array_end( ) {
+			return on_end( [&]( ) { return m_out.on_array_end( ); } );
+		}
+
+		parse_control_t on_key( daw::string_view key ) {
+			if( m_forward_depth > 0 ) {
+				return m_out.on_key( key, false );
+			} else if( m_dead_depth == 0 ) {
+				m_member_mask = m_path->member_mask( m_frames.back( ).mask, key );
+				if( m_member_mask == 0 ) {
+					return parse_control_t::skip;
+				}
+			}
+			return parse_control_t::proceed;
+		}
+
+		parse_control_t on_string( daw::string_view value ) {
+			return on_scalar( [&]( ) { return m_out.on_string( value, false ); } );
+		}
+
+		parse_control_t on_integer( daw::string_view value ) {
+			return on_scalar( [&]( ) { return m_out.on_integer( value ); } );
+		}
+
+		parse_control_t on_real( daw::string_view value ) {
+			return on_scalar( [&]( ) { return m_out.on_real( value ); } );
+		}
+
+		parse_control_t on_boolean( bool value ) {
+			return on_scalar( [&]( ) { return m_out.on_boolean( value ); } );
+		}
+
+		parse_control_t on_null( ) {
+			return on_scalar( [&]( ) { return m_out.on_null( ); } );
+		}
+
+		/// @brief Number of matches passed on so far
+		size_t match_count( ) const noexcept {
+			return m_match_count;
+		}
+	}; // json_path_filter_t
+} // namespace daw::json
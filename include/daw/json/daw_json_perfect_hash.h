@@ -0,0 +1,118 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include <daw/daw_string_view.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace daw::json::impl {
+	/// @brief Seeded FNV-1a over the bytes of key
+	constexpr uint64_t perfect_hash_value( daw::string_view key,
+	                                       uint64_t seed ) noexcept {
+		uint64_t result =
+		  0xcbf2'9ce4'8422'2325ULL ^ ( seed * 0x9E37'79B9'7F4A'7C15ULL );
+		for( auto c : key ) {
+			result ^= static_cast<unsigned char>( c );
+			result *= 0x0000'0100'0000'01B3ULL;
+		}
+		return result ^ ( result >> 29U );
+	}
+
+	/// @brief Minimal perfect hash over a fixed set of keys, built with the
+	/// hash and displace method.  Every key maps to a distinct slot in
+	/// [0, size( ) ) with two hashes and no probing.  Keys outside the set also
+	/// map to some slot, so callers must compare the key stored there
+	class perfect_hash_t {
+		std::vector<uint32_t> m_displacements;
+		size_t m_size;
+		// Seed of the hash that picks a key's bucket
+		uint64_t m_seed;
+
+		/// @return false when some bucket could not be placed with m_seed
+		bool try_place( std::vector<daw::string_view> const &keys );
+
+	public:
+		perfect_hash_t( ) noexcept;
+
+		/// @param keys distinct keys to hash
+		/// @throws std::runtime_error if keys holds duplicates
+		explicit perfect_hash_t( std::vector<daw::string_view> const &keys );
+
+		size_t size( ) const noexcept {
+			return m_size;
+		}
+
+		size_t slot( daw::string_view key ) const noexcept {
+			if( m_size == 0 ) {
+				return 0;
+			}
+			auto const bucket =
+			  perfect_hash_value( key, m_seed ) % m_displacements.size( );
+			return static_cast<size_t>(
+			  perfect_hash_value( key, m_displacements[bucket] ) % m_size );
+		}
+	}; // perfect_hash_t
+
+	/// @brief Read only map from a fixed set of names to values, looked up
+	/// with a single perfect hash probe and one key comparison
+	template<typename T>
+	class perfect_hash_map_t {
+		perfect_hash_t m_hash;
+		std::vector<std::pair<std::string, T>> m_items;
+
+	public:
+		perfect_hash_map_t( ) = default;
+
+		/// @param items name/value pairs with distinct names
+		explicit perfect_hash_map_t( std::vector<std::pair<std::string, T>> items )
+		  : m_hash{ }
+		  , m_items( items.size( ) ) {
+
+			std::vector<daw::string_view> keys{ };
+			keys.reserve( items.size( ) );
+			for( auto const &item : items ) {
+				keys.emplace_back( item.first.data( ), item.first.size( ) );
+			}
+			m_hash = perfect_hash_t( keys );
+			for( auto &item : items ) {
+				auto const pos = m_hash.slot(
+				  daw::string_view( item.first.data( ), item.first.size( ) ) );
+				m_items[pos] = std::move( item );
+			}
+		}
+
+		size_t size( ) const noexcept {
+			return m_items.size( );
+		}
+
+		bool empty( ) const noexcept {
+			return m_items.empty( );
+		}
+
+		/// @return pointer to the value for name, or nullptr when name is not
+		/// in the map
+		T const *find( daw::string_view name ) const noexcept {
+			if( m_items.empty( ) ) {
+				return nullptr;
+			}
+			auto const &item = m_items[m_hash.slot( name )];
+			if( item.first.size( ) != name.size( ) or
+			    item.first.compare( 0, item.first.size( ), name.data( ),
+			                        name.size( ) ) != 0 ) {
+				return nullptr;
+			}
+			return &item.second;
+		}
+	}; // perfect_hash_map_t
+} // namespace daw::json::impl
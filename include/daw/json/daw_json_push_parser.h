@@ -0,0 +1,442 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include "daw_json_async_io.h"
+#include "daw_json_file.h"
+#include "daw_json_parser_exception.h"
+#include "daw_json_parser_impl.h"
+#include "daw_json_text_parser.h"
+
+#include <daw/daw_string_view.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace daw::json {
+	/// @brief SAX parser that is fed the document in chunks of any size, e.g.
+	/// as they arrive from a socket.  A token split across chunks is held
+	/// until it is complete, and the events are the same as json_parser's.
+	/// Tokens that lie entirely within one chunk are reported as views into
+	/// that chunk, so a chunk only has to live until feed returns.  Events may
+	/// return a parse_control_t as with json_parser, skipped subtrees are
+	/// still checked for well formedness.  Like
+	/// json_parser, several top level values of any type may follow each
+	/// other.  A top level number is only reported once the character after
+	/// it, or finish, is seen.
+	///
+	/// After an exception the parser is left in an unspecified state and
+	/// must not be fed again
+	template<typename Handler>
+	class json_push_parser {
+		enum class expect_t : uint8_t {
+			value,
+			first_value,
+			key,
+			first_key,
+			colon,
+			separator
+		};
+		enum class token_t : uint8_t { none, key, string, number, literal };
+
+		impl::parser_proxy_t<Handler> m_proxy;
+		// '{' or '[' for each open object or array
+		std::vector<char> m_nesting{ };
+		// Start of the partial token within the current chunk
+		char const *m_token_first = nullptr;
+		char const *m_literal = nullptr;
+		size_t m_literal_pos = 0;
+		expect_t m_expect = expect_t::value;
+		token_t m_token = token_t::none;
+		bool m_in_escape = false;
+		bool m_has_escape = false;
+		// Open containers within a subtree the handler asked to skip
+		size_t m_skip_depth = 0;
+		// The skipped container's end event is still reported
+		bool m_report_skip_end = false;
+		// The next value belongs to a member whose on_key returned skip
+		bool m_skip_next = false;
+
+		static constexpr bool is_number_char( char c ) noexcept {
+			return ( '0' <= c and c <= '9' ) or c == '-' or c == '+' or c == '.' or
+			       c == 'e' or c == 'E';
+		}
+
+		/// @brief The text of the token ending at token_last, joined with any
+		/// part held over from earlier chunks
+		daw::string_view token_view( char const *token_last ) {
+			if( m_proxy.buffer.empty( ) ) {
+				return daw::string_view(
+				  m_token_first, static_cast<size_t>( token_last - m_token_first ) );
+			}
+			m_proxy.buffer.append( m_token_first, token_last );
+			return daw::string_view( m_proxy.buffer.data( ),
+			                         m_proxy.buffer.size( ) );
+		}
+
+		void start_token( token_t token, char const *token_first ) {
+			m_token = token;
+			m_token_first = token_first;
+			m_proxy.clear_buffer( );
+		}
+
+		void after_value( ) {
+			m_token = token_t::none;
+			m_expect = m_nesting.empty( ) ? expect_t::value : expect_t::separator;
+		}
+
+		void close( char open ) {
+			if( m_nesting.empty( ) or m_nesting.back( ) != open ) {
+				throw json_parser_exception( open == '{'
+				                               ? "Unexpected '}' outside of object"
+				                               : "Unexpected ']' outside of array" );
+			}
+			m_nesting.pop_back( );
+			after_value( );
+			if( m_skip_depth > 0 and
+			    ( --m_skip_depth > 0 or not m_report_skip_end ) ) {
+				return;
+			}
+			if( open == '{' ) {
+				m_proxy.on_object_end( );
+			} else {
+				m_proxy.on_array_end( );
+			}
+		}
+
+		void open_container( char open ) {
+			m_nesting.push_back( open );
+			m_expect = open == '{' ? expect_t::first_key : expect_t::first_value;
+			if( m_skip_depth > 0 ) {
+				++m_skip_depth;
+				return;
+			}
+			if( m_skip_next ) {
+				m_skip_next = false;
+				m_skip_depth = 1;
+				m_report_skip_end = false;
+				return;
+			}
+			auto const control = open == '{' ? m_proxy.on_object_begin( )
+			                                 : m_proxy.on_array_begin( );
+			if( control == parse_control_t::skip ) {
+				m_skip_depth = 1;
+				m_report_skip_end = true;
+			}
+		}
+
+		/// @brief Report a scalar value unless it is being skipped
+		template<typename Event>
+		void emit_scalar( Event event ) {
+			after_value( );
+			if( m_skip_depth > 0 ) {
+				return;
+			}
+			if( m_skip_next ) {
+				m_skip_next = false;
+				return;
+			}
+			event( );
+		}
+
+		void emit_number( char const *token_last ) {
+			auto const value = token_view( token_last );
+			auto rng = impl::text::make_text_range( value );
+			if( not impl::text::check_number( rng ) or not rng.empty( ) ) {
+				throw json_parser_exception(
+				  "Invalid number '" + std::string( value.data( ), value.size( ) ) +
+				  "'" );
+			}
+			bool is_real = false;
+			for( auto c : value ) {
+				is_real = is_real or c == '.' or c == 'e' or c == 'E';
+			}
+			emit_scalar( [&]( ) {
+				if( is_real ) {
+					m_proxy.on_real( value );
+				} else {
+					m_proxy.on_integer( value );
+				}
+			} );
+		}
+
+		void start_value( char const *first ) {
+			switch( *first ) {
+			case '{':
+			case '[':
+				open_container( *first );
+				return;
+			case '"':
+				start_token( token_t::string, first + 1 );
+				m_in_escape = false;
+				m_has_escape = false;
+				return;
+			case 't':
+				m_literal = "true";
+				break;
+			case 'f':
+				m_literal = "false";
+				break;
+			case 'n':
+				m_literal = "null";
+				break;
+			default:
+				if( *first == '-' or ( '0' <= *first and *first <= '9' ) ) {
+					start_token( token_t::number, first );
+					return;
+				}
+				throw json_parser_exception( "Unexpected character" );
+			}
+			m_token = token_t::literal;
+			m_literal_pos = 1;
+		}
+
+		/// @brief Handle the character at first when no token is in progress
+		void parse_structural( char const *first ) {
+			auto const c = *first;
+			if( impl::is_insignificant_ws( c ) ) {
+				return;
+			}
+			switch( m_expect ) {
+			case expect_t::first_value:
+				if( c == ']' ) {
+					close( '[' );
+					return;
+				}
+				start_value( first );
+				return;
+			case expect_t::value:
+				start_value( first );
+				return;
+			case expect_t::first_key:
+				if( c == '}' ) {
+					close( '{' );
+					return;
+				}
+				[[fallthrough]];
+			case expect_t::key:
+				if( c != '"' ) {
+					throw json_parser_exception( "Expected a member name" );
+				}
+				start_token( token_t::key, first + 1 );
+				m_in_escape = false;
+				m_has_escape = false;
+				return;
+			case expect_t::colon:
+				if( c != ':' ) {
+					throw json_parser_exception(
+					  "Unexpected character.  Expecting ':'" );
+				}
+				m_expect = expect_t::value;
+				return;
+			case expect_t::separator:
+				switch( c ) {
+				case ',':
+					m_expect =
+					  m_nesting.back( ) == '{' ? expect_t::key : expect_t::value;
+					return;
+				case '}':
+				case ']':
+					close( c == '}' ? '{' : '[' );
+					return;
+				default:
+					throw json_parser_exception( "Expected a comma" );
+				}
+			}
+		}
+
+		/// @return position after the closing quote, or last if the string
+		/// continues into the next chunk
+		char const *parse_string( char const *first, char const *last ) {
+			for( ; first != last; ++first ) {
+				if( m_in_escape ) {
+					m_in_escape = false;
+				} else if( *first == '\\' ) {
+					m_in_escape = true;
+					m_has_escape = true;
+				} else if( *first == '"' ) {
+					auto const raw = token_view( first );
+					if( m_token == token_t::key ) {
+						m_token = token_t::none;
+						m_expect = expect_t::colon;
+						if( m_skip_depth == 0 and
+						    m_proxy.on_key( raw, m_has_escape ) ==
+						      parse_control_t::skip ) {
+							m_skip_next = true;
+						}
+					} else {
+						emit_scalar(
+						  [&]( ) { m_proxy.on_string( raw, m_has_escape ); } );
+					}
+					return first + 1;
+				}
+			}
+			return last;
+		}
+
+		/// @return position after the number, or last if it may continue into
+		/// the next chunk
+		char const *parse_number( char const *first, char const *last ) {
+			while( first != last and is_number_char( *first ) ) {
+				++first;
+			}
+			if( first != last ) {
+				emit_number( first );
+			}
+			return first;
+		}
+
+		char const *parse_literal( char const *first, char const *last ) {
+			while( first != last and m_literal[m_literal_pos] != '\0' ) {
+				if( *first != m_literal[m_literal_pos] ) {
+					throw json_parser_exception( "Expected " +
+					                             std::string( m_literal ) );
+				}
+				++first;
+				++m_literal_pos;
+			}
+			if( m_literal[m_literal_pos] == '\0' ) {
+				emit_scalar( [&]( ) {
+					if( m_literal[0] == 'n' ) {
+						m_proxy.on_null( );
+					} else {
+						m_proxy.on_boolean( m_literal[0] == 't' );
+					}
+				} );
+			}
+			return first;
+		}
+
+	public:
+		explicit json_push_parser( Handler &handler )
+		  : m_proxy( handler ) {}
+
+		/// @brief Parse the next chunk of the document, reporting every token
+		/// completed within it
+		/// @return number of characters consumed, less than the chunk size only
+		/// when the handler stopped the parse
+		size_t feed( daw::string_view chunk ) {
+			if( is_stopped( ) ) {
+				return 0;
+			}
+			auto first = chunk.data( );
+			auto const last = chunk.data( ) + chunk.size( );
+			m_token_first = first;
+			while( first != last and not m_proxy.is_stopped( ) ) {
+				switch( m_token ) {
+				case token_t::none:
+					parse_structural( first );
+					++first;
+					break;
+				case token_t::key:
+				case token_t::string:
+					first = parse_string( first, last );
+					break;
+				case token_t::number:
+					first = parse_number( first, last );
+					break;
+				case token_t::literal:
+					first = parse_literal( first, last );
+					break;
+				}
+			}
+			if( m_token == token_t::key or m_token == token_t::string or
+			    m_token == token_t::number ) {
+				m_proxy.buffer.append( m_token_first, last );
+			}
+			return static_cast<size_t>( first - chunk.data( ) );
+		}
+
+		size_t feed( char const *first, char const *last ) {
+			return feed(
+			  daw::string_view( first, static_cast<size_t>( last - first ) ) );
+		}
+
+		/// @brief Signal the end of input.  Throws if the document stopped in
+		/// the middle of a token, object or array and the handler did not stop
+		/// the parse
+		void finish( ) {
+			if( is_stopped( ) ) {
+				return;
+			}
+			m_token_first = nullptr;
+			if( m_token == token_t::number ) {
+				emit_number( nullptr );
+			}
+			if( m_token != token_t::none or not m_nesting.empty( ) ) {
+				throw json_parser_exception( "Unexpected end of input" );
+			}
+		}
+
+		/// @brief true once an event returned parse_control_t::stop
+		bool is_stopped( ) const noexcept {
+			return m_proxy.is_stopped( );
+		}
+
+		/// @brief Number of objects and arrays currently open
+		size_t depth( ) const noexcept {
+			return m_nesting.size( );
+		}
+	}; // json_push_parser
+
+	/// @brief Parse everything left in source, one block at a time, reporting
+	/// the events to handler.  Memory use is one block plus any token that
+	/// spans blocks
+	/// @tparam BlockSource json_block_source_t, json_async_file_reader_t or
+	/// anything else whose next_block returns a string_view that is empty at
+	/// the end of input
+	template<typename BlockSource, typename Handler>
+	void json_parse_blocks( BlockSource &source, Handler &handler ) {
+		json_push_parser<Handler> parser( handler );
+		for( auto block = source.next_block( ); not block.empty( );
+		     block = source.next_block( ) ) {
+			parser.feed( block );
+			if( parser.is_stopped( ) ) {
+				return;
+			}
+		}
+		parser.finish( );
+	}
+
+	/// @brief Parse the rest of a stream, e.g. std::cin, without reading it
+	/// all into memory first
+	template<typename Handler>
+	void json_parse_stream(
+	  std::istream &is, Handler &handler,
+	  size_t block_size = json_block_source_t::default_block_size ) {
+		json_block_source_t source( is, block_size );
+		json_parse_blocks( source, handler );
+	}
+
+	/// @brief Parse the rest of an open file descriptor, e.g. a pipe or
+	/// socket, without reading it all into memory first
+	template<typename Handler>
+	void json_parse_fd(
+	  int fd, Handler &handler,
+	  size_t block_size = json_block_source_t::default_block_size ) {
+		json_block_source_t source( fd, block_size );
+		json_parse_blocks( source, handler );
+	}
+
+	/// @brief Parse a file while the blocks after the current one are read in
+	/// the background, so that waiting on the disk overlaps parsing
+	/// @param blocks_in_flight blocks that may be read ahead of the parser
+	template<typename Handler>
+	void json_parse_file(
+	  daw::string_view file_name, Handler &handler,
+	  size_t block_size = json_async_file_reader_t::default_block_size,
+	  size_t blocks_in_flight =
+	    json_async_file_reader_t::default_blocks_in_flight ) {
+		json_async_file_reader_t source( file_name, block_size, blocks_in_flight );
+		json_parse_blocks( source, handler );
+	}
+} // namespace daw::json
@@ -0,0 +1,130 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include "daw_json_file.h"
+#include "daw_json_value_t.h"
+
+#include <daw/daw_string_view.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace daw::json {
+	/// @brief Type of a value stored in a json snapshot
+	enum class json_snapshot_type_t : uint32_t {
+		null,
+		boolean,
+		integer,
+		real,
+		string,
+		array,
+		object
+	};
+
+	/// @brief Read only view of one value in a json snapshot.  The snapshot is
+	/// read in place, nothing is copied or parsed until to_json_value.
+	/// Every node stores its size, so stepping to the n'th element or member
+	/// is O(1).  Offsets are checked against the enclosing node as they are
+	/// followed, corrupt data throws instead of reading out of bounds
+	class json_snapshot_view_t {
+		char const *m_node;
+		size_t m_size;
+
+		json_snapshot_view_t( char const *node, size_t available );
+
+		uint64_t load_u64( size_t offset ) const;
+		void check_type( json_snapshot_type_t expected ) const;
+		json_snapshot_view_t child( size_t table_offset ) const;
+
+		friend json_snapshot_view_t open_json_snapshot( daw::string_view data );
+
+	public:
+		json_snapshot_type_t type( ) const noexcept;
+
+		bool is_null( ) const noexcept;
+		bool is_boolean( ) const noexcept;
+		bool is_integer( ) const noexcept;
+		bool is_real( ) const noexcept;
+		bool is_string( ) const noexcept;
+		bool is_array( ) const noexcept;
+		bool is_object( ) const noexcept;
+
+		/// @throws std::runtime_error if the value is of another type
+		bool get_boolean( ) const;
+		json_value_t::integer_t get_integer( ) const;
+		json_value_t::real_t get_real( ) const;
+		/// @return view into the snapshot, valid as long as the snapshot is
+		daw::string_view get_string( ) const;
+
+		/// @brief Number of elements of an array or members of an object, 0 for
+		/// anything else
+		size_t size( ) const;
+
+		/// @brief Element index of an array
+		/// @throws std::runtime_error if this is not an array or index is out of
+		/// range
+		json_snapshot_view_t operator[]( size_t index ) const;
+
+		/// @brief Name of member index of an object
+		daw::string_view key_at( size_t index ) const;
+
+		/// @brief Value of member index of an object
+		json_snapshot_view_t value_at( size_t index ) const;
+
+		/// @brief First member named key, empty if there is none
+		std::optional<json_snapshot_view_t> find( daw::string_view key ) const;
+
+		/// @brief Copy this value and everything below it into a json_value_t
+		/// @throws std::runtime_error if values are nested more than 512 deep
+		json_value_t to_json_value( ) const;
+	}; // json_snapshot_view_t
+
+	/// @brief Serialize value into the snapshot format: a small header and
+	/// then one node per value.  Nodes hold their type and total size, arrays
+	/// and objects start with a table of offsets to their children, and no
+	/// pointers are stored, so the result can be written to disk and memory
+	/// mapped again later.  Numbers are stored in the byte order of the
+	/// machine that wrote them
+	std::string to_json_snapshot( json_value_t const &value );
+
+	/// @brief View the root of a snapshot held in data, e.g. a mapped file
+	/// @throws std::runtime_error if data is not a snapshot or was written
+	/// with another byte order
+	json_snapshot_view_t open_json_snapshot( daw::string_view data );
+
+	/// @brief Write to_json_snapshot( value ) to file_name
+	void write_json_snapshot_file( daw::string_view file_name,
+	                               json_value_t const &value,
+	                               bool overwrite = true );
+
+	/// @brief Memory mapped snapshot file.  root is ready as soon as the file
+	/// is mapped, there is no parse step
+	class json_snapshot_file_t {
+		json_file_t m_file;
+		json_snapshot_view_t m_root;
+
+	public:
+		/// @throws std::runtime_error if the file cannot be opened or is not a
+		/// snapshot
+		explicit json_snapshot_file_t( daw::string_view file_name );
+
+		// root points into m_file
+		json_snapshot_file_t( json_snapshot_file_t const & ) = delete;
+		json_snapshot_file_t &operator=( json_snapshot_file_t const & ) = delete;
+		json_snapshot_file_t( json_snapshot_file_t && ) = delete;
+		json_snapshot_file_t &operator=( json_snapshot_file_t && ) = delete;
+		~json_snapshot_file_t( ) = default;
+
+		/// @brief The top level value, valid for the life of this object
+		json_snapshot_view_t root( ) const noexcept;
+	}; // json_snapshot_file_t
+} // namespace daw::json
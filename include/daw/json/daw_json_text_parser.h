@@ -0,0 +1,406 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#pragma once
+
+#include "daw_json_value_t.h"
+
+#include <daw/daw_string_view.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+// Helpers for decoding json text straight into C++ values.  They walk a pair
+// of pointers over the text and never build json_value_t nodes.  Each parse_
+// function expects any leading whitespace to have been skipped and leaves the
+// range positioned just after the value it consumed
+namespace daw::json::impl::text {
+	struct text_range_t {
+		char const *first;
+		char const *last;
+
+		constexpr bool empty( ) const noexcept {
+			return first == last;
+		}
+
+		constexpr size_t size( ) const noexcept {
+			return static_cast<size_t>( last - first );
+		}
+
+		constexpr char front( ) const noexcept {
+			return *first;
+		}
+	}; // text_range_t
+
+	inline text_range_t make_text_range( daw::string_view json_text ) noexcept {
+		return text_range_t{ json_text.data( ),
+		                     json_text.data( ) + json_text.size( ) };
+	}
+
+	/// @brief An array in the text being decoded.  Passed to the set functions
+	/// of array members so they can decode the elements in place
+	struct array_source_t {
+		text_range_t *range;
+	};
+
+	/// @brief An object in the text being decoded.  Passed to the set
+	/// functions of object members
+	struct object_source_t {
+		text_range_t *range;
+	};
+
+	[[noreturn]] void throw_parse_error( daw::string_view message );
+
+	/// @brief Append the unescaped form of the contents of a json string
+	void unescape_string( daw::string_view escaped, std::string &out );
+
+	json_value_t::real_t parse_real( text_range_t &rng );
+
+	/// @brief Move past the value at the front of rng without decoding it
+	void skip_value( text_range_t &rng );
+
+	constexpr bool is_ws( char c ) noexcept {
+		return c == 0x20 or c == 0x0A or c == 0x0D or c == 0x09;
+	}
+
+	inline void skip_ws( text_range_t &rng ) noexcept {
+		while( not rng.empty( ) and is_ws( *rng.first ) ) {
+			++rng.first;
+		}
+	}
+
+	inline bool consume_if( text_range_t &rng, char c ) noexcept {
+		if( not rng.empty( ) and *rng.first == c ) {
+			++rng.first;
+			return true;
+		}
+		return false;
+	}
+
+	inline void expect( text_range_t &rng, char c ) {
+		if( not consume_if( rng, c ) ) {
+			char const msg[] = { 'E', 'x', 'p', 'e', 'c', 't', 'e', 'd', ' ', '\'',
+			                     c,   '\'' };
+			throw_parse_error( daw::string_view( msg, sizeof( msg ) ) );
+		}
+	}
+
+	inline bool consume_literal( text_range_t &rng,
+	                             daw::string_view literal ) noexcept {
+		if( rng.size( ) < literal.size( ) ) {
+			return false;
+		}
+		for( size_t n = 0; n < literal.size( ); ++n ) {
+			if( rng.first[n] != literal[n] ) {
+				return false;
+			}
+		}
+		rng.first += literal.size( );
+		return true;
+	}
+
+	// Word at a time helpers used to scan past long runs of bytes that cannot
+	// end a string or change the nesting depth, eight bytes per step
+	namespace swar {
+		constexpr uint64_t ones = 0x0101'0101'0101'0101ULL;
+		constexpr uint64_t highs = 0x8080'8080'8080'8080ULL;
+
+		inline uint64_t load( char const *ptr ) noexcept {
+			uint64_t result;
+			std::memcpy( &result, ptr, sizeof( result ) );
+			return result;
+		}
+
+		constexpr uint64_t broadcast( char c ) noexcept {
+			return ones * static_cast<unsigned char>( c );
+		}
+
+		/// @brief true when any byte of word equals the byte repeated in pattern
+		constexpr bool has_byte( uint64_t word, uint64_t pattern ) noexcept {
+			auto const v = word ^ pattern;
+			return ( ( v - ones ) & ~v & highs ) != 0;
+		}
+
+		/// @brief true when word holds a '"' or '\\'
+		constexpr bool has_string_special( uint64_t word ) noexcept {
+			return has_byte( word, broadcast( '"' ) ) or
+			       has_byte( word, broadcast( '\\' ) );
+		}
+
+		/// @brief true when word holds a '"', '[', ']', '{' or '}'.  Setting
+		/// bit 5 folds the brackets onto the braces
+		constexpr bool has_structural( uint64_t word ) noexcept {
+			auto const folded = word | broadcast( 0x20 );
+			return has_byte( word, broadcast( '"' ) ) or
+			       has_byte( folded, broadcast( '{' ) ) or
+			       has_byte( folded, broadcast( '}' ) );
+		}
+	} // namespace swar
+
+	/// @brief Find the closing quote of a string whose contents start at first
+	/// @param has_escape set to true when a '\\' is seen
+	/// @return pointer to the closing quote
+	inline char const *find_string_end( char const *first, char const *last,
+	                                    bool &has_escape ) {
+		while( first != last ) {
+			while( last - first >= 8 and
+			       not swar::has_string_special( swar::load( first ) ) ) {
+				first += 8;
+			}
+			if( first == last ) {
+				break;
+			}
+			if( *first == '"' ) {
+				return first;
+			}
+			if( *first == '\\' ) {
+				has_escape = true;
+				if( ++first == last ) {
+					break;
+				}
+			}
+			++first;
+		}
+		throw_parse_error( "Unexpected end of data in string" );
+	}
+
+	/// @brief The contents of the string at the front of rng, escapes still
+	/// in place
+	inline daw::string_view parse_raw_string( text_range_t &rng,
+	                                          bool &has_escape ) {
+		expect( rng, '"' );
+		auto const str_first = rng.first;
+		auto const str_last = find_string_end( str_first, rng.last, has_escape );
+		rng.first = str_last + 1;
+		return daw::string_view( str_first,
+		                         static_cast<size_t>( str_last - str_first ) );
+	}
+
+	inline void parse_string( text_range_t &rng, std::string &out ) {
+		bool has_escape = false;
+		auto const raw = parse_raw_string( rng, has_escape );
+		if( has_escape ) {
+			out.clear( );
+			unescape_string( raw, out );
+		} else {
+			out.assign( raw.data( ), raw.size( ) );
+		}
+	}
+
+	/// @brief Per thread buffer for decoding strings whose destination cannot
+	/// be written directly.  Its capacity grows to the longest string seen
+	inline std::string &scratch_string( ) {
+		thread_local std::string s_buffer{ };
+		return s_buffer;
+	}
+
+	inline std::string parse_string( text_range_t &rng ) {
+		std::string result{ };
+		parse_string( rng, result );
+		return result;
+	}
+
+	inline json_value_t::integer_t parse_integer( text_range_t &rng ) {
+		using integer_t = json_value_t::integer_t;
+		using unsigned_t = std::make_unsigned_t<integer_t>;
+		bool const is_negative = consume_if( rng, '-' );
+		if( rng.empty( ) or
+		    static_cast<unsigned char>( *rng.first - '0' ) > 9U ) {
+			throw_parse_error( "Expected an integer" );
+		}
+		auto const limit =
+		  static_cast<unsigned_t>( std::numeric_limits<integer_t>::max( ) ) +
+		  ( is_negative ? 1U : 0U );
+		unsigned_t result = 0;
+		while( not rng.empty( ) ) {
+			auto const digit = static_cast<unsigned char>( *rng.first - '0' );
+			if( digit > 9U ) {
+				break;
+			}
+			if( result > ( limit - digit ) / 10U ) {
+				throw_parse_error( "Integer does not fit in integer_t" );
+			}
+			result = result * 10U + digit;
+			++rng.first;
+		}
+		if( not rng.empty( ) and ( *rng.first == '.' or *rng.first == 'e' or
+		                           *rng.first == 'E' ) ) {
+			throw_parse_error( "Expected an integer, found a real" );
+		}
+		if( is_negative ) {
+			return static_cast<integer_t>( ~result + 1U );
+		}
+		return static_cast<integer_t>( result );
+	}
+
+	inline bool parse_boolean( text_range_t &rng ) {
+		if( consume_literal( rng, "true" ) ) {
+			return true;
+		}
+		if( consume_literal( rng, "false" ) ) {
+			return false;
+		}
+		throw_parse_error( "Expected a boolean" );
+	}
+
+	/// @brief Call on_element( rng ) with rng positioned at each element of the
+	/// array at the front of rng
+	template<typename Function>
+	void parse_array( text_range_t &rng, Function on_element ) {
+		expect( rng, '[' );
+		skip_ws( rng );
+		if( consume_if( rng, ']' ) ) {
+			return;
+		}
+		while( true ) {
+			skip_ws( rng );
+			on_element( rng );
+			skip_ws( rng );
+			if( consume_if( rng, ',' ) ) {
+				continue;
+			}
+			expect( rng, ']' );
+			return;
+		}
+	}
+
+	/// @brief Call on_member( name, rng ) with rng positioned at the value of
+	/// each member of the object at the front of rng.  name is the raw member
+	/// name, has_escape tells if it needs unescaping before use
+	template<typename Function>
+	void parse_object( text_range_t &rng, Function on_member ) {
+		expect( rng, '{' );
+		skip_ws( rng );
+		if( consume_if( rng, '}' ) ) {
+			return;
+		}
+		while( true ) {
+			skip_ws( rng );
+			bool has_escape = false;
+			auto const name = parse_raw_string( rng, has_escape );
+			skip_ws( rng );
+			expect( rng, ':' );
+			skip_ws( rng );
+			on_member( name, has_escape, rng );
+			skip_ws( rng );
+			if( consume_if( rng, ',' ) ) {
+				continue;
+			}
+			expect( rng, '}' );
+			return;
+		}
+	}
+
+	// Validation.  The check_ functions move rng past a value like the parse_
+	// functions do, but only report whether the value is well formed and of
+	// the expected type.  They do not throw on bad input, so rejecting costs
+	// no more than accepting
+
+	/// @brief Check that rng starts with a well formed string
+	bool check_string( text_range_t &rng ) noexcept;
+
+	/// @brief Check that rng starts with an integer in [min_value, max_value]
+	bool check_integer( text_range_t &rng, json_value_t::integer_t min_value,
+	                    json_value_t::integer_t max_value ) noexcept;
+
+	/// @brief Check that rng starts with a number in the JSON grammar
+	bool check_number( text_range_t &rng ) noexcept;
+
+	bool check_boolean( text_range_t &rng ) noexcept;
+
+	/// @brief Check that rng starts with any well formed json value
+	bool check_value( text_range_t &rng ) noexcept;
+
+	/// @brief Check the array at the front of rng, calling
+	/// on_element( rng ) -> bool for each element
+	template<typename Function>
+	bool check_array( text_range_t &rng, Function on_element ) {
+		if( not consume_if( rng, '[' ) ) {
+			return false;
+		}
+		skip_ws( rng );
+		if( consume_if( rng, ']' ) ) {
+			return true;
+		}
+		while( true ) {
+			skip_ws( rng );
+			if( rng.empty( ) or not on_element( rng ) ) {
+				return false;
+			}
+			skip_ws( rng );
+			if( consume_if( rng, ',' ) ) {
+				continue;
+			}
+			return consume_if( rng, ']' );
+		}
+	}
+
+	/// @brief Check the object at the front of rng, calling
+	/// on_member( name, has_escape, rng ) -> bool for each member
+	template<typename Function>
+	bool check_object( text_range_t &rng, Function on_member ) {
+		if( not consume_if( rng, '{' ) ) {
+			return false;
+		}
+		skip_ws( rng );
+		if( consume_if( rng, '}' ) ) {
+			return true;
+		}
+		while( true ) {
+			skip_ws( rng );
+			auto const name_first = rng.first + 1;
+			bool has_escape = false;
+			if( rng.empty( ) or *rng.first != '"' ) {
+				return false;
+			}
+			for( auto it = name_first; it != rng.last and *it != '"'; ++it ) {
+				if( *it == '\\' ) {
+					has_escape = true;
+					break;
+				}
+			}
+			if( not check_string( rng ) ) {
+				return false;
+			}
+			auto const name = daw::string_view(
+			  name_first, static_cast<size_t>( rng.first - 1 - name_first ) );
+			skip_ws( rng );
+			if( not consume_if( rng, ':' ) ) {
+				return false;
+			}
+			skip_ws( rng );
+			if( rng.empty( ) or not on_member( name, has_escape, rng ) ) {
+				return false;
+			}
+			skip_ws( rng );
+			if( consume_if( rng, ',' ) ) {
+				continue;
+			}
+			return consume_if( rng, '}' );
+		}
+	}
+
+	/// @brief Decode the value at the front of rng as a T.  Used for the
+	/// elements of arrays of integers, reals, booleans and strings
+	template<typename T>
+	T parse_as( text_range_t &rng ) {
+		if constexpr( std::is_same_v<T, bool> ) {
+			return parse_boolean( rng );
+		} else if constexpr( std::is_integral_v<T> ) {
+			return static_cast<T>( parse_integer( rng ) );
+		} else if constexpr( std::is_floating_point_v<T> ) {
+			return static_cast<T>( parse_real( rng ) );
+		} else {
+			return T( parse_string( rng ) );
+		}
+	}
+} // namespace daw::json::impl::text
@@ -0,0 +1,238 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#include <daw/json/daw_json_async_io.h>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_move.h>
+#include <daw/daw_string_view.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace daw::json {
+	namespace {
+		[[noreturn]] void throw_io_error( char const *message ) {
+			throw std::runtime_error( std::string( message ) + ": " +
+			                          std::strerror( errno ) );
+		}
+
+		int open_file( daw::string_view file_name, int flags ) {
+			auto const fname = std::string( file_name.data( ), file_name.size( ) );
+			auto const fd = ::open( fname.c_str( ), flags | O_CLOEXEC, 0644 );
+			if( fd < 0 ) {
+				throw_io_error( "Could not open file" );
+			}
+			return fd;
+		}
+	} // namespace
+
+	json_async_file_reader_t::json_async_file_reader_t(
+	  daw::string_view file_name, size_t block_size, size_t blocks_in_flight )
+	  : m_blocks( )
+	  , m_block_size( block_size )
+	  , m_fd( -1 ) {
+
+		daw::exception::precondition_check( block_size > 0 and
+		                                      blocks_in_flight > 0,
+		                                    "Block size and count must be "
+		                                    "greater than 0" );
+		for( size_t n = 0; n < blocks_in_flight; ++n ) {
+			m_blocks.push_back(
+			  block_t{ std::make_unique<char[]>( block_size ), 0 } );
+		}
+		m_fd = open_file( file_name, O_RDONLY );
+#ifdef POSIX_FADV_SEQUENTIAL
+		(void)::posix_fadvise( m_fd, 0, 0, POSIX_FADV_SEQUENTIAL );
+#endif
+		try {
+			m_thread = std::thread( [this]( ) { read_blocks( ); } );
+		} catch( ... ) {
+			::close( m_fd );
+			throw;
+		}
+	}
+
+	json_async_file_reader_t::~json_async_file_reader_t( ) {
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_is_closing = true;
+		}
+		m_cv.notify_all( );
+		m_thread.join( );
+		::close( m_fd );
+	}
+
+	void json_async_file_reader_t::read_blocks( ) {
+		off_t offset = 0;
+		size_t index = 0;
+		while( true ) {
+			{
+				std::unique_lock<std::mutex> lock( m_mutex );
+				// The block being parsed is not counted in m_ready but must not
+				// be overwritten either
+				m_cv.wait( lock, [&]( ) {
+					return m_is_closing or
+					       m_ready + ( m_has_current ? 1U : 0U ) < m_blocks.size( );
+				} );
+				if( m_is_closing ) {
+					return;
+				}
+			}
+			auto &block = m_blocks[index];
+			ssize_t count = 0;
+			do {
+				count = ::pread( m_fd, block.data.get( ), m_block_size, offset );
+			} while( count < 0 and errno == EINTR );
+			{
+				std::lock_guard<std::mutex> lock( m_mutex );
+				if( count < 0 ) {
+					try {
+						throw_io_error( "Error reading file" );
+					} catch( ... ) { m_error = std::current_exception( ); }
+				} else if( count == 0 ) {
+					m_is_eof = true;
+				} else {
+					block.size = static_cast<size_t>( count );
+					offset += count;
+					++m_ready;
+				}
+			}
+			m_cv.notify_all( );
+			if( count <= 0 ) {
+				return;
+			}
+			index = ( index + 1 ) % m_blocks.size( );
+		}
+	}
+
+	daw::string_view json_async_file_reader_t::next_block( ) {
+		std::unique_lock<std::mutex> lock( m_mutex );
+		if( m_has_current ) {
+			m_current = ( m_current + 1 ) % m_blocks.size( );
+		}
+		m_has_current = false;
+		m_cv.notify_all( );
+		m_cv.wait( lock,
+		           [&]( ) { return m_ready > 0 or m_is_eof or m_error; } );
+		if( m_ready == 0 ) {
+			if( m_error ) {
+				std::rethrow_exception( m_error );
+			}
+			return daw::string_view( );
+		}
+		--m_ready;
+		m_has_current = true;
+		auto const &block = m_blocks[m_current];
+		return daw::string_view( block.data.get( ), block.size );
+	}
+
+	json_async_file_writer_t::json_async_file_writer_t(
+	  daw::string_view file_name, size_t max_queued )
+	  : m_max_queued( max_queued )
+	  , m_fd( -1 ) {
+
+		daw::exception::precondition_check( max_queued > 0,
+		                                    "max_queued must be greater than 0" );
+		m_fd = open_file( file_name, O_WRONLY | O_CREAT | O_TRUNC );
+		try {
+			m_thread = std::thread( [this]( ) { write_buffers( ); } );
+		} catch( ... ) {
+			::close( m_fd );
+			throw;
+		}
+	}
+
+	json_async_file_writer_t::~json_async_file_writer_t( ) {
+		join( );
+	}
+
+	void json_async_file_writer_t::write_buffers( ) {
+		while( true ) {
+			std::string buffer{ };
+			{
+				std::unique_lock<std::mutex> lock( m_mutex );
+				m_cv.wait( lock,
+				           [&]( ) { return m_is_closing or not m_queue.empty( ); } );
+				if( m_queue.empty( ) ) {
+					return;
+				}
+				buffer = daw::move( m_queue.front( ) );
+				m_queue.pop_front( );
+			}
+			m_cv.notify_all( );
+			auto first = buffer.data( );
+			auto const last = buffer.data( ) + buffer.size( );
+			while( first != last ) {
+				auto const count =
+				  ::write( m_fd, first, static_cast<size_t>( last - first ) );
+				if( count < 0 ) {
+					if( errno == EINTR ) {
+						continue;
+					}
+					std::lock_guard<std::mutex> lock( m_mutex );
+					try {
+						throw_io_error( "Error writing file" );
+					} catch( ... ) { m_error = std::current_exception( ); }
+					m_queue.clear( );
+					m_cv.notify_all( );
+					return;
+				}
+				first += count;
+			}
+		}
+	}
+
+	void json_async_file_writer_t::write( std::string buffer ) {
+		{
+			std::unique_lock<std::mutex> lock( m_mutex );
+			m_cv.wait( lock, [&]( ) {
+				return m_is_closing or m_error or m_queue.size( ) < m_max_queued;
+			} );
+			if( m_is_closing ) {
+				throw std::runtime_error( "Writer is closed" );
+			}
+			if( m_error ) {
+				std::rethrow_exception( m_error );
+			}
+			m_queue.push_back( daw::move( buffer ) );
+		}
+		m_cv.notify_all( );
+	}
+
+	void json_async_file_writer_t::join( ) {
+		if( not m_thread.joinable( ) ) {
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_is_closing = true;
+		}
+		m_cv.notify_all( );
+		m_thread.join( );
+		if( ::close( m_fd ) != 0 and not m_error ) {
+			try {
+				throw_io_error( "Error closing file" );
+			} catch( ... ) { m_error = std::current_exception( ); }
+		}
+	}
+
+	void json_async_file_writer_t::close( ) {
+		join( );
+		if( m_error ) {
+			std::rethrow_exception( m_error );
+		}
+	}
+} // namespace daw::json
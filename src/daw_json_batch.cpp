@@ -0,0 +1,69 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#include <daw/json/daw_json_batch.h>
+#include <daw/json/daw_json_file.h>
+#include <daw/json/daw_json_parallel.h>
+#include <daw/json/daw_json_parser.h>
+
+#include <daw/daw_string_view.h>
+
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace daw::json {
+	namespace {
+		json_obj parse_one_file( std::string const &path ) {
+			auto const in_file = json_file_t( path );
+			if( not in_file ) {
+				throw std::runtime_error( "Could not open file" );
+			}
+			return parse_json_checked( in_file.to_string_view( ) );
+		}
+	} // namespace
+
+	std::vector<json_file_result_t>
+	parse_files( std::vector<std::string> const &paths, size_t max_in_flight ) {
+		std::vector<json_file_result_t> results( paths.size( ) );
+		// One file per chunk, the files are independent and usually small so
+		// handing them out one at a time keeps the workers evenly loaded
+		impl::parallel_for_chunks(
+		  paths.size( ), 1, max_in_flight, [&]( size_t first, size_t, size_t ) {
+			  auto &result = results[first];
+			  result.path = paths[first];
+			  try {
+				  result.value = parse_one_file( result.path );
+			  } catch( ... ) { result.error = std::current_exception( ); }
+		  } );
+		return results;
+	}
+
+	std::vector<json_file_result_t> parse_directory( daw::string_view directory,
+	                                                 size_t max_in_flight ) {
+		namespace fs = boost::filesystem;
+		auto const dir_path =
+		  fs::path( std::string( directory.data( ), directory.size( ) ) );
+		std::vector<std::string> paths{ };
+		try {
+			for( auto const &entry : fs::directory_iterator( dir_path ) ) {
+				if( fs::is_regular_file( entry.status( ) ) ) {
+					paths.push_back( entry.path( ).string( ) );
+				}
+			}
+		} catch( fs::filesystem_error const &ex ) {
+			throw std::runtime_error( std::string( "Could not read directory: " ) +
+			                          ex.what( ) );
+		}
+		std::sort( paths.begin( ), paths.end( ) );
+		return parse_files( paths, max_in_flight );
+	}
+} // namespace daw::json
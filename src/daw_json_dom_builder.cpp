@@ -0,0 +1,98 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#include <daw/json/daw_json_dom_builder.h>
+
+#include <daw/json/daw_json_parser_exception.h>
+#include <daw/json/daw_json_parser_v2.h>
+
+#include <daw/daw_move.h>
+#include <daw/daw_string_view.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace daw::json {
+	void json_dom_builder_t::add_value( json_value_t value ) {
+		if( m_open.empty( ) ) {
+			m_values.push_back( daw::move( value ) );
+		} else if( m_open.back( ).is_array( ) ) {
+			m_open.back( ).get_array( ).push_back( daw::move( value ) );
+		} else {
+			m_open.back( ).get_object( ).push_back( make_object_value_item(
+			  daw::move( m_keys.back( ) ), daw::move( value ) ) );
+			m_keys.pop_back( );
+		}
+	}
+
+	void json_dom_builder_t::close_container( ) {
+		auto value = daw::move( m_open.back( ) );
+		m_open.pop_back( );
+		add_value( daw::move( value ) );
+	}
+
+	void json_dom_builder_t::on_object_begin( ) {
+		m_open.emplace_back( json_object_value( ) );
+	}
+
+	void json_dom_builder_t::on_object_end( ) {
+		close_container( );
+	}
+
+	void json_dom_builder_t::on_array_begin( ) {
+		m_open.emplace_back( json_array_value( ) );
+	}
+
+	void json_dom_builder_t::on_array_end( ) {
+		close_container( );
+	}
+
+	void json_dom_builder_t::on_key( daw::string_view key ) {
+		m_keys.emplace_back( key );
+	}
+
+	void json_dom_builder_t::on_string( daw::string_view value ) {
+		add_value( json_value_t( value ) );
+	}
+
+	void json_dom_builder_t::on_integer( daw::string_view, intmax_t value ) {
+		add_value( json_value_t( value ) );
+	}
+
+	void json_dom_builder_t::on_real( daw::string_view, double value ) {
+		add_value( json_value_t( value ) );
+	}
+
+	void json_dom_builder_t::on_boolean( bool value ) {
+		add_value( json_value_t( value ) );
+	}
+
+	void json_dom_builder_t::on_null( ) {
+		add_value( json_value_t( ) );
+	}
+
+	std::vector<json_value_t> &json_dom_builder_t::values( ) noexcept {
+		return m_values;
+	}
+
+	json_value_t json_dom_builder_t::take_value( ) {
+		if( m_values.size( ) != 1 or not m_open.empty( ) ) {
+			throw json_parser_exception( "Expected a single top level value" );
+		}
+		auto result = daw::move( m_values.back( ) );
+		m_values.clear( );
+		return result;
+	}
+
+	json_value_t build_json_value( daw::string_view json_text ) {
+		json_dom_builder_t builder{ };
+		json_parser( json_text.data( ), json_text.data( ) + json_text.size( ),
+		             builder );
+		return builder.take_value( );
+	}
+} // namespace daw::json
@@ -0,0 +1,241 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#include <daw/json/daw_json_file.h>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_memory_mapped_file.h>
+#include <daw/daw_move.h>
+#include <daw/daw_string_view.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace daw::json {
+	namespace {
+		// Deflate cannot expand data by more than about 1032 to 1
+		constexpr size_t max_compression_ratio = 1032;
+		constexpr size_t gzip_trailer_size = 8;
+		constexpr size_t inflate_block_size = 64U * 1024U;
+
+		/// @brief Guess the inflated size from the ISIZE field of the gzip
+		/// trailer.  ISIZE is the size modulo 2^32 and only describes the last
+		/// member, so it is only used to reserve memory, the result still grows
+		/// as needed
+		size_t expected_inflated_size( daw::string_view compressed_data ) {
+			if( compressed_data.size( ) < gzip_trailer_size ) {
+				return 0;
+			}
+			auto const trailer = reinterpret_cast<unsigned char const *>(
+			  compressed_data.data( ) + compressed_data.size( ) - 4 );
+			auto const isize = static_cast<size_t>( trailer[0] ) |
+			                   ( static_cast<size_t>( trailer[1] ) << 8U ) |
+			                   ( static_cast<size_t>( trailer[2] ) << 16U ) |
+			                   ( static_cast<size_t>( trailer[3] ) << 24U );
+			// A corrupt trailer must not cause a huge allocation
+			return std::min( isize, compressed_data.size( ) * max_compression_ratio );
+		}
+
+		std::string gzip_compress( daw::string_view text ) {
+			namespace bio = boost::iostreams;
+			std::string result{ };
+			{
+				bio::filtering_ostream out_stream{ };
+				out_stream.push( bio::gzip_compressor( ) );
+				out_stream.push( bio::back_inserter( result ) );
+				out_stream.write( text.data( ),
+				                  static_cast<std::streamsize>( text.size( ) ) );
+				if( not out_stream ) {
+					throw std::runtime_error( "Error compressing file" );
+				}
+				// Flush the gzip trailer into result
+				out_stream.reset( );
+			}
+			return result;
+		}
+	} // namespace
+
+	bool is_gzip_data( daw::string_view data ) noexcept {
+		return data.size( ) >= 2 and
+		       static_cast<unsigned char>( data[0] ) == 0x1FU and
+		       static_cast<unsigned char>( data[1] ) == 0x8BU;
+	}
+
+	std::string gzip_decompress( daw::string_view compressed_data ) {
+		namespace bio = boost::iostreams;
+		bio::filtering_istream in_stream{ };
+		in_stream.push( bio::gzip_decompressor( ) );
+		in_stream.push(
+		  bio::array_source( compressed_data.data( ), compressed_data.size( ) ) );
+
+		std::string result{ };
+		result.reserve( expected_inflated_size( compressed_data ) );
+		std::array<char, inflate_block_size> block{ };
+		// The filtering stream turns filter errors into badbit, which would
+		// otherwise end the loop like a normal end of input
+		in_stream.exceptions( std::ios::badbit );
+		try {
+			while( in_stream ) {
+				in_stream.read( block.data( ), block.size( ) );
+				result.append( block.data( ),
+				               static_cast<size_t>( in_stream.gcount( ) ) );
+			}
+		} catch( std::ios::failure const &ex ) {
+			// gzip_error and zlib_error are both ios::failure
+			throw std::runtime_error( std::string( "Error decompressing file: " ) +
+			                          ex.what( ) );
+		}
+		return result;
+	}
+
+	json_file_t::json_file_t( daw::string_view file_name )
+	  : m_file( std::string( file_name.data( ), file_name.size( ) ).c_str( ) )
+	  , m_inflated{ }
+	  , m_is_compressed{ false }
+	  , m_is_empty{ false } {
+
+		if( not m_file ) {
+			auto const fname = std::string( file_name.data( ), file_name.size( ) );
+			boost::system::error_code ec{ };
+			m_is_empty = boost::filesystem::is_regular_file( fname, ec ) and
+			             boost::filesystem::file_size( fname, ec ) == 0 and
+			             not ec;
+			return;
+		}
+		if( is_gzip_data( daw::string_view( m_file.data( ), m_file.size( ) ) ) ) {
+			m_inflated =
+			  gzip_decompress( daw::string_view( m_file.data( ), m_file.size( ) ) );
+			m_is_compressed = true;
+		}
+	}
+
+	json_file_t::~json_file_t( ) = default;
+
+	json_file_t::operator bool( ) const noexcept {
+		return m_is_compressed or m_is_empty or static_cast<bool>( m_file );
+	}
+
+	bool json_file_t::is_compressed( ) const noexcept {
+		return m_is_compressed;
+	}
+
+	char const *json_file_t::begin( ) const noexcept {
+		if( m_is_compressed or m_is_empty ) {
+			return m_inflated.data( );
+		}
+		return m_file.data( );
+	}
+
+	char const *json_file_t::end( ) const noexcept {
+		return begin( ) + size( );
+	}
+
+	size_t json_file_t::size( ) const noexcept {
+		if( m_is_compressed or m_is_empty ) {
+			return m_inflated.size( );
+		}
+		return m_file.size( );
+	}
+
+	daw::string_view json_file_t::to_string_view( ) const noexcept {
+		return daw::string_view( begin( ), size( ) );
+	}
+
+	json_block_source_t::json_block_source_t( std::istream &is,
+	                                          size_t block_size )
+	  : m_buffer( std::make_unique<char[]>( block_size ) )
+	  , m_block_size( block_size )
+	  , m_stream( &is )
+	  , m_fd( -1 ) {
+
+		daw::exception::precondition_check( block_size > 0,
+		                                    "block_size must be greater than 0" );
+	}
+
+	json_block_source_t::json_block_source_t( int fd, size_t block_size )
+	  : m_buffer( std::make_unique<char[]>( block_size ) )
+	  , m_block_size( block_size )
+	  , m_stream( nullptr )
+	  , m_fd( fd ) {
+
+		daw::exception::precondition_check( block_size > 0,
+		                                    "block_size must be greater than 0" );
+	}
+
+	daw::string_view json_block_source_t::next_block( ) {
+		if( m_stream != nullptr ) {
+			auto const count = m_stream->rdbuf( )->sgetn(
+			  m_buffer.get( ), static_cast<std::streamsize>( m_block_size ) );
+			if( count <= 0 ) {
+				m_stream->setstate( std::ios::eofbit );
+				return daw::string_view( );
+			}
+			return daw::string_view( m_buffer.get( ), static_cast<size_t>( count ) );
+		}
+		while( true ) {
+			auto const count = ::read( m_fd, m_buffer.get( ), m_block_size );
+			if( count >= 0 ) {
+				return daw::string_view( m_buffer.get( ),
+				                         static_cast<size_t>( count ) );
+			}
+			if( errno != EINTR ) {
+				throw std::runtime_error( std::string( "Error reading input: " ) +
+				                          std::strerror( errno ) );
+			}
+		}
+	}
+
+	std::string read_all( json_block_source_t &source ) {
+		std::string result{ };
+		for( auto block = source.next_block( ); not block.empty( );
+		     block = source.next_block( ) ) {
+			result.append( block.data( ), block.size( ) );
+		}
+		return result;
+	}
+
+	void write_json_file( daw::string_view file_name,
+	                      daw::string_view json_text, bool overwrite,
+	                      bool compress ) {
+		daw::exception::daw_throw_on_false( not file_name.empty( ) );
+		auto const fname = std::string( file_name.data( ), file_name.size( ) );
+		if( not overwrite and boost::filesystem::exists( fname ) ) {
+			throw std::runtime_error( "Overwrite not permitted and file exists" );
+		}
+		std::string compressed{ };
+		if( compress ) {
+			compressed = gzip_compress( json_text );
+			json_text = daw::string_view( compressed.data( ), compressed.size( ) );
+		}
+		std::ofstream out_file( fname.c_str( ), std::ios::out | std::ios::trunc |
+		                                          std::ios::binary );
+		if( not out_file.is_open( ) ) {
+			throw std::runtime_error( "Could not open file for writing" );
+		}
+		out_file.write( json_text.data( ),
+		                static_cast<std::streamsize>( json_text.size( ) ) );
+		out_file.close( );
+		if( not out_file ) {
+			throw std::runtime_error( "Error writing file" );
+		}
+	}
+} // namespace daw::json
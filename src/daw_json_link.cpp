@@ -6,10 +6,13 @@
 // Official repository: https://github.com/beached/parse_json
 //
 
+#include <daw/json/daw_json_interface.h>
 #include <daw/json/daw_json_link.h>
+#include <daw/json/daw_value_to_json.h>
 
 #include <daw/daw_string_view.h>
 
+#include <ostream>
 #include <string>
 
 namespace daw::json::impl {
@@ -24,9 +27,7 @@ namespace daw::json::impl {
 	}
 
 	std::string to_json_string( daw::string_view s ) {
-		std::string result;
-		result = "\"" + static_cast<std::string>( s ) + "\"";
-		return result;
+		return enquote( s );
 	}
 
 	std::string to_json_boolean( bool b ) {
@@ -38,3 +39,24 @@ namespace daw::json::impl {
 		return "null"s;
 	}
 } // namespace daw::json::impl
+
+namespace daw::json {
+	namespace {
+		void append_json_value( std::string &json_text,
+		                        json_value_t const &value ) {
+			json_text += generate::value_to_json( daw::string_view{ }, value );
+		}
+	} // namespace
+
+	std::string array_to_json_string( json_array_value const &values,
+	                                  size_t thread_count ) {
+		return impl::impl::to_json_array_parallel( values, append_json_value,
+		                                           thread_count );
+	}
+
+	void array_to_json_stream( std::ostream &os, json_array_value const &values,
+	                           size_t thread_count ) {
+		impl::impl::to_json_array_parallel( os, values, append_json_value,
+		                                    thread_count );
+	}
+} // namespace daw::json
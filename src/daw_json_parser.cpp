@@ -7,6 +7,7 @@
 //
 
 #include <daw/json/daw_json_interface.h>
+#include <daw/json/daw_json_parallel.h>
 
 #include <daw/daw_move.h>
 #include <daw/daw_range.h>
@@ -15,10 +16,13 @@
 
 #include <algorithm>
 #include <boost/lexical_cast.hpp>
+#include <cstdint>
 #include <iterator>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace daw::json {
 	JsonParserException::JsonParserException( std::string msg ) noexcept
@@ -299,14 +303,107 @@ namespace daw::json {
 			return result;
 		}
 
+		// Position of the scan within the text when splitting an array for
+		// parse_json_parallel.  A '\\' is taken to escape the next character
+		// wherever it is, as outside of strings it is invalid anyway
+		struct split_state_t {
+			intmax_t depth = 0;
+			bool in_string = false;
+			bool escaped = false;
+		};
+
+		// Quotes in [first, last) that are not escaped
+		size_t count_quotes( char const *first, char const *last,
+		                     bool &escaped ) noexcept {
+			size_t result = 0;
+			for( ; first != last; ++first ) {
+				if( escaped ) {
+					escaped = false;
+				} else if( *first == '\\' ) {
+					escaped = true;
+				} else if( *first == '"' ) {
+					++result;
+				}
+			}
+			return result;
+		}
+
+		// Advance state over c.  Returns true when c is a comma separating the
+		// elements of the outermost array
+		bool split_step( split_state_t &state, char c ) noexcept {
+			if( state.escaped ) {
+				state.escaped = false;
+				return false;
+			}
+			if( c == '\\' ) {
+				state.escaped = true;
+				return false;
+			}
+			if( state.in_string ) {
+				state.in_string = c != '"';
+				return false;
+			}
+			switch( c ) {
+			case '"':
+				state.in_string = true;
+				return false;
+			case '[':
+			case '{':
+				++state.depth;
+				return false;
+			case ']':
+			case '}':
+				--state.depth;
+				return false;
+			case ',':
+				return state.depth == 1;
+			default:
+				return false;
+			}
+		}
+
+		// Parse the elements in range, a slice of the outermost array's body
+		// that ends just after a separating comma or, for the last slice, at
+		// the end of the document
+		void parse_array_slice( range::utf_range &range, json_array_value &out,
+		                        bool is_last ) {
+			skip_ws( range );
+			if( is_last and is_equal( range.begin( ), U']' ) ) {
+				// Empty array
+				++range;
+				return;
+			}
+			while( !at_end( range ) ) {
+				out.push_back( parse_value( range ) );
+				if( is_last and is_equal( range.begin( ), U']' ) ) {
+					++range;
+					return;
+				}
+				if( !is_equal( range.begin( ), U',' ) ) {
+					throw JsonParserException( "Not a valid JSON array" );
+				}
+				++range;
+				skip_ws( range );
+			}
+			if( is_last ) {
+				throw JsonParserException( "Not a valid JSON array" );
+			}
+		}
 	} // namespace impl
 
-	json_obj parse_json( range::char_iterator Begin, range::char_iterator End ) {
-		try {
+	namespace impl {
+		json_obj parse_document( range::char_iterator Begin,
+		                         range::char_iterator End ) {
 			range::utf_iterator it_begin( Begin );
 			range::utf_iterator it_end( End );
 			range::utf_range range{ it_begin, it_end };
-			return impl::parse_value( range );
+			return parse_value( range );
+		}
+	} // namespace impl
+
+	json_obj parse_json( range::char_iterator Begin, range::char_iterator End ) {
+		try {
+			return impl::parse_document( Begin, End );
 		} catch( JsonParserException const & ) {
 			return daw::json::json_value_t{ };
 		}
@@ -316,4 +413,147 @@ namespace daw::json {
 		return parse_json( json_text.begin( ), json_text.end( ) );
 	}
 
+	json_obj parse_json_checked( daw::string_view json_text ) {
+		try {
+			return impl::parse_document( json_text.begin( ), json_text.end( ) );
+		} catch( JsonParserException const &ex ) {
+			throw std::runtime_error( "Error parsing json: " + ex.message );
+		}
+	}
+
+	json_obj parse_json_parallel( daw::string_view json_text,
+	                              size_t thread_count ) {
+		constexpr size_t min_chunk_bytes = 1024U * 1024U;
+		auto first = json_text.data( );
+		auto const last = json_text.data( ) + json_text.size( );
+		while( first != last and impl::is_ws( static_cast<unsigned char>(
+		                           *first ) ) ) {
+			++first;
+		}
+		if( first == last or *first != '[' ) {
+			return parse_json( json_text );
+		}
+		++first;
+		auto const body_size = static_cast<size_t>( last - first );
+		if( thread_count == 0 ) {
+			thread_count = impl::default_thread_count( );
+		}
+		auto const chunk_bytes =
+		  std::max( body_size / ( thread_count * 4U ), min_chunk_bytes );
+		auto const chunk_count = ( body_size + chunk_bytes - 1 ) / chunk_bytes;
+		if( chunk_count < 2 ) {
+			return parse_json( json_text );
+		}
+		auto const chunk_first = [&]( size_t chunk ) {
+			return first + chunk * chunk_bytes;
+		};
+		auto const chunk_last = [&]( size_t chunk ) {
+			return chunk + 1 == chunk_count ? last : chunk_first( chunk + 1 );
+		};
+
+		// Whether a chunk starts inside a string depends only on the quote
+		// parity of everything before it.  Count each chunk's quotes in
+		// parallel, for both possible escape states at its start when its
+		// first character makes a difference, then resolve them in order
+		struct quote_count_t {
+			size_t quotes[2];
+			bool escaped_at_end[2];
+		};
+		std::vector<quote_count_t> quote_counts( chunk_count );
+		impl::parallel_for_chunks(
+		  chunk_count, 1, thread_count, [&]( size_t chunk, size_t, size_t ) {
+			  auto &qc = quote_counts[chunk];
+			  for( size_t n = 0; n < 2; ++n ) {
+				  auto const c = *chunk_first( chunk );
+				  if( n == 1 and c != '"' and c != '\\' ) {
+					  qc.quotes[1] = qc.quotes[0];
+					  qc.escaped_at_end[1] = qc.escaped_at_end[0];
+					  break;
+				  }
+				  bool escaped = n == 1;
+				  qc.quotes[n] = impl::count_quotes( chunk_first( chunk ),
+				                                     chunk_last( chunk ), escaped );
+				  qc.escaped_at_end[n] = escaped;
+			  }
+		  } );
+		std::vector<impl::split_state_t> chunk_states( chunk_count );
+		chunk_states[0].depth = 1;
+		for( size_t chunk = 1; chunk < chunk_count; ++chunk ) {
+			auto const &prev = chunk_states[chunk - 1];
+			auto const &qc = quote_counts[chunk - 1];
+			chunk_states[chunk].in_string =
+			  prev.in_string != ( qc.quotes[prev.escaped] % 2 == 1 );
+			chunk_states[chunk].escaped = qc.escaped_at_end[prev.escaped];
+		}
+
+		// With the string state known, nesting depth changes can be counted in
+		// parallel and summed to give the depth at the start of each chunk
+		std::vector<intmax_t> depth_changes( chunk_count );
+		impl::parallel_for_chunks(
+		  chunk_count, 1, thread_count, [&]( size_t chunk, size_t, size_t ) {
+			  auto state = chunk_states[chunk];
+			  state.depth = 0;
+			  for( auto it = chunk_first( chunk ); it != chunk_last( chunk ); ++it ) {
+				  (void)impl::split_step( state, *it );
+			  }
+			  depth_changes[chunk] = state.depth;
+		  } );
+		for( size_t chunk = 1; chunk < chunk_count; ++chunk ) {
+			chunk_states[chunk].depth =
+			  chunk_states[chunk - 1].depth + depth_changes[chunk - 1];
+		}
+
+		// Each chunk's slice of elements starts after the first separating
+		// comma in it.  A chunk without one is inside a larger element
+		std::vector<char const *> slice_firsts( chunk_count, nullptr );
+		slice_firsts[0] = first;
+		impl::parallel_for_chunks(
+		  chunk_count - 1, 1, thread_count, [&]( size_t n, size_t, size_t ) {
+			  auto const chunk = n + 1;
+			  auto state = chunk_states[chunk];
+			  for( auto it = chunk_first( chunk ); it != chunk_last( chunk ); ++it ) {
+				  if( impl::split_step( state, *it ) ) {
+					  slice_firsts[chunk] = std::next( it );
+					  return;
+				  }
+			  }
+		  } );
+		slice_firsts.erase(
+		  std::remove( slice_firsts.begin( ), slice_firsts.end( ), nullptr ),
+		  slice_firsts.end( ) );
+
+		std::vector<json_array_value> slices( slice_firsts.size( ) );
+		try {
+			impl::parallel_for_chunks(
+			  slices.size( ), 1, thread_count, [&]( size_t slice, size_t, size_t ) {
+				  auto const is_last = slice + 1 == slices.size( );
+				  range::utf_iterator it_begin( slice_firsts[slice] );
+				  range::utf_iterator it_end( is_last ? last
+				                                      : slice_firsts[slice + 1] );
+				  range::utf_range range{ it_begin, it_end };
+				  impl::parse_array_slice( range, slices[slice], is_last );
+				  if( is_last ) {
+					  impl::skip_ws( range );
+					  if( !at_end( range ) ) {
+						  throw JsonParserException( "Unexpected data after array" );
+					  }
+				  }
+			  } );
+		} catch( JsonParserException const & ) {
+			return daw::json::json_value_t{ };
+		}
+
+		size_t element_count = 0;
+		for( auto const &slice : slices ) {
+			element_count += slice.size( );
+		}
+		json_array_value result{ };
+		result.reserve( element_count );
+		for( auto &slice : slices ) {
+			std::move( slice.begin( ), slice.end( ), std::back_inserter( result ) );
+			slice = json_array_value( );
+		}
+		return json_value_t( daw::move( result ) );
+	}
+
 } // namespace daw::json
@@ -18,77 +18,51 @@
 #include <vector>
 
 namespace daw::json::state {
-	void state_t::on_object_begin( ) {
+	void state_t::on_object_begin( state_control_t & ) {
 		daw::exception::daw_throw<std::runtime_error>(
 		  this->to_string( ) + ": Unexpected state change: on_object_begin" );
 	}
 
-	void state_t::on_object_end( ) {
+	void state_t::on_object_end( state_control_t & ) {
 		daw::exception::daw_throw<std::runtime_error>(
 		  this->to_string( ) + ": Unexpected state change: on_object_end" );
 	}
 
-	void state_t::on_array_begin( ) {
+	void state_t::on_array_begin( state_control_t & ) {
 		daw::exception::daw_throw<std::runtime_error>(
 		  this->to_string( ) + ": Unexpected state change: on_array_begin" );
 	}
 
-	void state_t::on_array_end( ) {
+	void state_t::on_array_end( state_control_t & ) {
 		daw::exception::daw_throw<std::runtime_error>(
 		  this->to_string( ) + ": Unexpected state change: on_array_end" );
 	}
 
-	void state_t::on_string( daw::string_view ) {
+	void state_t::on_string( state_control_t &, daw::string_view ) {
 		daw::exception::daw_throw<std::runtime_error>(
 		  this->to_string( ) + ": Unexpected state change: on_string" );
 	}
 
-	void state_t::on_integer( daw::string_view ) {
+	void state_t::on_integer( state_control_t &, daw::string_view ) {
 		daw::exception::daw_throw<std::runtime_error>(
 		  this->to_string( ) + ": Unexpected state change: on_integer" );
 	}
 
-	void state_t::on_real( daw::string_view ) {
+	void state_t::on_real( state_control_t &, daw::string_view ) {
 		daw::exception::daw_throw<std::runtime_error>(
 		  this->to_string( ) + ": Unexpected state change: on_real" );
 	}
 
-	void state_t::on_boolean( bool ) {
+	void state_t::on_boolean( state_control_t &, bool ) {
 		daw::exception::daw_throw<std::runtime_error>(
 		  this->to_string( ) + ": Unexpected state change: on_boolean" );
 	}
 
-	void state_t::on_null( ) {
+	void state_t::on_null( state_control_t & ) {
 		daw::exception::daw_throw<std::runtime_error>(
 		  this->to_string( ) + ": Unexpected state change: on_null" );
 	}
 
-	std::vector<state_t *> &state_stack( ) {
-		static std::vector<state_t *> result = {
-		  get_state_fn( current_state_t::none ) };
-		return result;
-	}
-
-	state_t &current_state( ) {
-		return *state_stack( ).back( );
-	}
-
-	void push_and_set_next_state( current_state_t s ) {
-		state_stack( ).push_back( get_state_fn( s ) );
-	}
-
-	void set_next_state( current_state_t s ) {
-		state_stack( ).back( ) = get_state_fn( s );
-	}
-
-	void pop_state( ) {
-		state_stack( ).pop_back( );
-	}
-
-	void pop_value( ) {
-		// value_stack( ).pop_back( );
-	}
-
 	//
 	// state_in_object_name
 	//
@@ -99,17 +73,18 @@ namespace daw::json::state {
 		return "state_in_object_name";
 	}
 
-	void state_in_object_name_t::on_string( daw::string_view ) {
+	void state_in_object_name_t::on_string( state_control_t &control,
+	                                        daw::string_view ) {
 		// json_value_t name{ value };
 
 		// Set current object name json_value_t
-		set_next_state( current_state_t::in_object_value );
+		control.set_next_state( current_state_t::in_object_value );
 	}
 
-	void state_in_object_name_t::on_object_end( ) {
+	void state_in_object_name_t::on_object_end( state_control_t &control ) {
 		// Save json_value_t
 		// Assumes state is not empty
-		pop_state( );
+		control.pop_state( );
 	}
 
 	state_in_object_value_t::~state_in_object_value_t( ) {}
@@ -118,50 +93,53 @@ namespace daw::json::state {
 		return "state_in_object_value";
 	}
 
-	void state_in_object_value_t::on_object_begin( ) {
+	void state_in_object_value_t::on_object_begin( state_control_t &control ) {
 		// Save data
 		// push_and_set_next_value( json_value_t{ } );
-		set_next_state( current_state_t::in_object_name );
-		push_and_set_next_state( current_state_t::in_object_name );
+		control.set_next_state( current_state_t::in_object_name );
+		control.push_and_set_next_state( current_state_t::in_object_name );
 	}
 
-	void state_in_object_value_t::on_array_begin( ) {
+	void state_in_object_value_t::on_array_begin( state_control_t &control ) {
 		// push_and_set_next_value( json_value_t{ } );
-		set_next_state( current_state_t::in_object_name );
-		push_and_set_next_state( current_state_t::in_array );
+		control.set_next_state( current_state_t::in_object_name );
+		control.push_and_set_next_state( current_state_t::in_array );
 	}
 
-	void state_in_object_value_t::on_null( ) {
+	void state_in_object_value_t::on_null( state_control_t &control ) {
 		// Value is already null
-		set_next_state( current_state_t::in_object_name );
+		control.set_next_state( current_state_t::in_object_name );
 	}
 
 	//
 	// state_in_object_value
 	//
 
-	void state_in_object_value_t::on_integer( daw::string_view ) {
+	void state_in_object_value_t::on_integer( state_control_t &control,
+	                                          daw::string_view ) {
 		// Save data
 		// current_value( ) = json_value_t{ to_integer( value ) };
-		set_next_state( current_state_t::in_object_name );
+		control.set_next_state( current_state_t::in_object_name );
 	}
 
-	void state_in_object_value_t::on_real( daw::string_view ) {
+	void state_in_object_value_t::on_real( state_control_t &control,
+	                                       daw::string_view ) {
 		// Save data
 		// current_value( ) = json_value_t{ to_real( value ) };
-		set_next_state( current_state_t::in_object_name );
+		control.set_next_state( current_state_t::in_object_name );
 	}
 
-	void state_in_object_value_t::on_string( daw::string_view ) {
+	void state_in_object_value_t::on_string( state_control_t &control,
+	                                         daw::string_view ) {
 		// Save data
 		// current_value( ) = json_value_t{ value.to_string( ) };
-		set_next_state( current_state_t::in_object_name );
+		control.set_next_state( current_state_t::in_object_name );
 	}
 
-	void state_in_object_value_t::on_boolean( bool ) {
+	void state_in_object_value_t::on_boolean( state_control_t &control, bool ) {
 		// Save data
 		// current_value( ) = json_value_t{ value };
-		set_next_state( current_state_t::in_object_name );
+		control.set_next_state( current_state_t::in_object_name );
 	}
 
 	//
@@ -174,37 +152,37 @@ namespace daw::json::state {
 		return "state_in_array";
 	}
 
-	void state_in_array_t::on_object_begin( ) {
+	void state_in_array_t::on_object_begin( state_control_t &control ) {
 		// Save data
-		push_and_set_next_state( current_state_t::in_object_name );
+		control.push_and_set_next_state( current_state_t::in_object_name );
 	}
 
-	void state_in_array_t::on_array_begin( ) {
+	void state_in_array_t::on_array_begin( state_control_t &control ) {
 		// Save data
-		push_and_set_next_state( current_state_t::in_array );
+		control.push_and_set_next_state( current_state_t::in_array );
 	}
 
-	void state_in_array_t::on_array_end( ) {
+	void state_in_array_t::on_array_end( state_control_t &control ) {
 		// Save data
-		pop_state( );
+		control.pop_state( );
 	}
-	void state_in_array_t::on_null( ) {
+	void state_in_array_t::on_null( state_control_t & ) {
 		// Save data
 	}
 
-	void state_in_array_t::on_integer( daw::string_view ) {
+	void state_in_array_t::on_integer( state_control_t &, daw::string_view ) {
 		// Save data
 	}
 
-	void state_in_array_t::on_real( daw::string_view ) {
+	void state_in_array_t::on_real( state_control_t &, daw::string_view ) {
 		// Save data
 	}
 
-	void state_in_array_t::on_string( daw::string_view ) {
+	void state_in_array_t::on_string( state_control_t &, daw::string_view ) {
 		// Save data
 	}
 
-	void state_in_array_t::on_boolean( bool ) {
+	void state_in_array_t::on_boolean( state_control_t &, bool ) {
 		// Save data
 	}
 
@@ -218,33 +196,33 @@ namespace daw::json::state {
 		return "state_none";
 	}
 
-	void state_none_t::on_object_begin( ) {
+	void state_none_t::on_object_begin( state_control_t &control ) {
 		// Save data
-		push_and_set_next_state( current_state_t::in_object_name );
+		control.push_and_set_next_state( current_state_t::in_object_name );
 	}
 
-	void state_none_t::on_array_begin( ) {
+	void state_none_t::on_array_begin( state_control_t &control ) {
 		// Save data
-		push_and_set_next_state( current_state_t::in_array );
+		control.push_and_set_next_state( current_state_t::in_array );
 	}
 
-	void state_none_t::on_null( ) {
+	void state_none_t::on_null( state_control_t & ) {
 		// Save data
 	}
 
-	void state_none_t::on_integer( daw::string_view ) {
+	void state_none_t::on_integer( state_control_t &, daw::string_view ) {
 		// Save data
 	}
 
-	void state_none_t::on_real( daw::string_view ) {
+	void state_none_t::on_real( state_control_t &, daw::string_view ) {
 		// Save data
 	}
 
-	void state_none_t::on_string( daw::string_view ) {
+	void state_none_t::on_string( state_control_t &, daw::string_view ) {
 		// Save data
 	}
 
-	void state_none_t::on_boolean( bool ) {
+	void state_none_t::on_boolean( state_control_t &, bool ) {
 		// Save data
 	}
 
@@ -269,51 +247,63 @@ namespace daw::json::state {
 		}
 	}
 
+	state_control_t::state_control_t( )
+	  : m_state_stack{ get_state_fn( current_state_t::none ) } {}
+
 	state_t const &state_control_t::current_state( ) const {
-		return daw::json::state::current_state( );
+		return *m_state_stack.back( );
+	}
+
+	void state_control_t::push_and_set_next_state( current_state_t s ) {
+		m_state_stack.push_back( get_state_fn( s ) );
+	}
+
+	void state_control_t::set_next_state( current_state_t s ) {
+		m_state_stack.back( ) = get_state_fn( s );
 	}
 
-	void state_control_t::clear_buffer( ) {
-		buffer.clear( );
+	void state_control_t::pop_state( ) {
+		m_state_stack.pop_back( );
 	}
 
-	void state_control_t::push( char c ) {
-		buffer.push_back( c );
+	void state_control_t::on_object_begin( ) {
+		m_state_stack.back( )->on_object_begin( *this );
 	}
 
-	void state_control_t::on_object_begin( ) const {
-		daw::json::state::current_state( ).on_object_begin( );
+	void state_control_t::on_object_end( ) {
+		m_state_stack.back( )->on_object_end( *this );
 	}
 
-	void state_control_t::on_object_end( ) const {
-		daw::json::state::current_state( ).on_object_end( );
+	void state_control_t::on_array_begin( ) {
+		m_state_stack.back( )->on_array_begin( *this );
 	}
 
-	void state_control_t::on_array_begin( ) const {
-		daw::json::state::current_state( ).on_array_begin( );
+	void state_control_t::on_array_end( ) {
+		m_state_stack.back( )->on_array_end( *this );
 	}
 
-	void state_control_t::on_array_end( ) const {
-		daw::json::state::current_state( ).on_array_end( );
+	void state_control_t::on_key( daw::string_view key ) {
+		// Member names drive the same transition as a string in the name state
+		m_state_stack.back( )->on_string( *this, key );
 	}
 
-	void state_control_t::on_string( daw::string_view value ) const {
-		daw::json::state::current_state( ).on_string( value );
+	void state_control_t::on_string( daw::string_view value ) {
+		m_state_stack.back( )->on_string( *this, value );
 	}
 
-	void state_control_t::on_integer( daw::string_view value ) const {
-		daw::json::state::current_state( ).on_integer( value );
+	void state_control_t::on_integer( daw::string_view value ) {
+		m_state_stack.back( )->on_integer( *this, value );
 	}
 
-	void state_control_t::on_real( daw::string_view value ) const {
-		daw::json::state::current_state( ).on_real( value );
+	void state_control_t::on_real( daw::string_view value ) {
+		m_state_stack.back( )->on_real( *this, value );
 	}
 
-	void state_control_t::on_boolean( bool value ) const {
-		daw::json::state::current_state( ).on_boolean( value );
+	void state_control_t::on_boolean( bool value ) {
+		m_state_stack.back( )->on_boolean( *this, value );
 	}
 
-	void state_control_t::on_null( ) const {
-		daw::json::state::current_state( ).on_null( );
+	void state_control_t::on_null( ) {
+		m_state_stack.back( )->on_null( *this );
 	}
 } // namespace daw::json::state
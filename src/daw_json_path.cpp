@@ -0,0 +1,154 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#include <daw/json/daw_json_path.h>
+
+#include <daw/json/daw_json_parser_exception.h>
+
+#include <daw/daw_string_view.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace daw::json {
+	namespace {
+		[[noreturn]] void throw_path_error( daw::string_view path,
+		                                    char const *message ) {
+			throw json_parser_exception( "Invalid JSONPath '" +
+			                             std::string( path.data( ), path.size( ) ) +
+			                             "': " + message );
+		}
+
+		constexpr bool is_name_char( char c ) noexcept {
+			return c != '.' and c != '[' and c != ']' and c != '\'' and c != '"';
+		}
+	} // namespace
+
+	json_path_t::json_path_t( daw::string_view path ) {
+		size_t pos = 0;
+		auto const at = [&]( size_t n ) {
+			return pos + n < path.size( ) ? path[pos + n] : '\0';
+		};
+		if( at( 0 ) != '$' ) {
+			throw_path_error( path, "must start with $" );
+		}
+		++pos;
+		while( pos < path.size( ) ) {
+			step_t step{ std::string( ), 0, step_kind_t::wildcard, false };
+			if( at( 0 ) == '.' and at( 1 ) == '.' ) {
+				step.is_descendant = true;
+				pos += 2;
+			} else if( at( 0 ) == '.' ) {
+				++pos;
+			} else if( at( 0 ) != '[' ) {
+				throw_path_error( path, "expected '.' or '['" );
+			}
+			if( at( 0 ) == '[' ) {
+				++pos;
+				if( at( 0 ) == '*' ) {
+					++pos;
+				} else if( at( 0 ) == '\'' or at( 0 ) == '"' ) {
+					auto const quote = at( 0 );
+					auto const name_first = ++pos;
+					while( pos < path.size( ) and at( 0 ) != quote ) {
+						++pos;
+					}
+					if( pos == path.size( ) ) {
+						throw_path_error( path, "unclosed quoted name" );
+					}
+					step.name.assign( path.data( ) + name_first, pos - name_first );
+					step.kind = step_kind_t::name;
+					++pos;
+				} else if( '0' <= at( 0 ) and at( 0 ) <= '9' ) {
+					while( '0' <= at( 0 ) and at( 0 ) <= '9' ) {
+						auto const digit = static_cast<size_t>( at( 0 ) - '0' );
+						if( step.index >
+						    ( std::numeric_limits<size_t>::max( ) - digit ) / 10U ) {
+							throw_path_error( path, "index is too large" );
+						}
+						step.index = step.index * 10U + digit;
+						++pos;
+					}
+					step.kind = step_kind_t::index;
+				} else {
+					throw_path_error( path,
+					                  "expected *, an index or a quoted name" );
+				}
+				if( at( 0 ) != ']' ) {
+					throw_path_error( path, "expected ']'" );
+				}
+				++pos;
+			} else if( at( 0 ) == '*' ) {
+				++pos;
+			} else {
+				auto const name_first = pos;
+				while( pos < path.size( ) and is_name_char( at( 0 ) ) ) {
+					++pos;
+				}
+				if( pos == name_first ) {
+					throw_path_error( path, "expected a member name" );
+				}
+				step.name.assign( path.data( ) + name_first, pos - name_first );
+				step.kind = step_kind_t::name;
+			}
+			if( m_steps.size( ) == max_steps ) {
+				throw_path_error( path, "too many steps" );
+			}
+			m_steps.push_back( std::move( step ) );
+		}
+	}
+
+	json_path_t::step_mask_t
+	json_path_t::child_mask( step_mask_t parent, daw::string_view key,
+	                         size_t index, bool is_index ) const noexcept {
+		step_mask_t result = 0;
+		for( size_t n = 0; n < m_steps.size( ); ++n ) {
+			if( ( parent & ( step_mask_t{ 1 } << n ) ) == 0 ) {
+				continue;
+			}
+			auto const &step = m_steps[n];
+			if( step.is_descendant ) {
+				// The step can still match further down
+				result |= step_mask_t{ 1 } << n;
+			}
+			bool const is_step_match =
+			  step.kind == step_kind_t::wildcard or
+			  ( step.kind == step_kind_t::index and is_index and
+			    step.index == index ) or
+			  ( step.kind == step_kind_t::name and not is_index and
+			    key == daw::string_view( step.name.data( ), step.name.size( ) ) );
+			if( is_step_match ) {
+				result |= step_mask_t{ 1 } << ( n + 1 );
+			}
+		}
+		return result;
+	}
+
+	json_path_t::step_mask_t
+	json_path_t::member_mask( step_mask_t parent,
+	                          daw::string_view key ) const noexcept {
+		return child_mask( parent, key, 0, false );
+	}
+
+	json_path_t::step_mask_t
+	json_path_t::element_mask( step_mask_t parent,
+	                           size_t index ) const noexcept {
+		return child_mask( parent, daw::string_view( ), index, true );
+	}
+
+	bool json_path_t::is_match( step_mask_t mask ) const noexcept {
+		return ( mask & ( step_mask_t{ 1 } << m_steps.size( ) ) ) != 0;
+	}
+
+	size_t json_path_t::size( ) const noexcept {
+		return m_steps.size( );
+	}
+} // namespace daw::json
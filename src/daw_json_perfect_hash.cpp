@@ -0,0 +1,108 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#include <daw/json/daw_json_perfect_hash.h>
+
+#include <daw/daw_string_view.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace daw::json::impl {
+	namespace {
+		// Small sets are placed with a few displacements.  A bucket that still
+		// does not fit is given up on and the keys are bucketed again with
+		// another seed, so clusters of colliding names cannot stall the build
+		constexpr uint32_t max_displacement = 1U << 16U;
+		constexpr uint64_t max_bucket_seed = 64;
+	} // namespace
+
+	perfect_hash_t::perfect_hash_t( ) noexcept
+	  : m_displacements{ }
+	  , m_size{ 0 }
+	  , m_seed{ 0 } {}
+
+	perfect_hash_t::perfect_hash_t( std::vector<daw::string_view> const &keys )
+	  : m_displacements( std::max( keys.size( ), static_cast<size_t>( 1 ) ), 0U )
+	  , m_size{ keys.size( ) }
+	  , m_seed{ 0 } {
+
+		if( keys.empty( ) ) {
+			return;
+		}
+		auto sorted_keys = keys;
+		std::sort( sorted_keys.begin( ), sorted_keys.end( ) );
+		if( std::adjacent_find( sorted_keys.begin( ), sorted_keys.end( ) ) !=
+		    sorted_keys.end( ) ) {
+			throw std::runtime_error(
+			  "Could not build member lookup table, there are duplicate names" );
+		}
+		for( ; m_seed < max_bucket_seed; ++m_seed ) {
+			if( try_place( keys ) ) {
+				return;
+			}
+		}
+		throw std::runtime_error( "Could not build member lookup table" );
+	}
+
+	bool perfect_hash_t::try_place( std::vector<daw::string_view> const &keys ) {
+		auto const bucket_count = m_displacements.size( );
+		std::vector<std::vector<size_t>> buckets( bucket_count );
+		for( size_t n = 0; n < keys.size( ); ++n ) {
+			buckets[perfect_hash_value( keys[n], m_seed ) % bucket_count].push_back(
+			  n );
+		}
+		// Place the largest buckets first while most slots are still free
+		std::vector<size_t> order( bucket_count );
+		std::iota( order.begin( ), order.end( ), static_cast<size_t>( 0 ) );
+		std::stable_sort( order.begin( ), order.end( ),
+		                  [&buckets]( size_t lhs, size_t rhs ) {
+			                  return buckets[lhs].size( ) > buckets[rhs].size( );
+		                  } );
+
+		std::vector<bool> is_used( m_size, false );
+		std::vector<size_t> slots{ };
+		for( auto const bucket : order ) {
+			auto const &members = buckets[bucket];
+			if( members.empty( ) ) {
+				break;
+			}
+			uint32_t displacement = 1;
+			for( ; displacement < max_displacement; ++displacement ) {
+				slots.clear( );
+				bool is_good = true;
+				for( auto const key_pos : members ) {
+					auto const slot = static_cast<size_t>(
+					  perfect_hash_value( keys[key_pos], displacement ) % m_size );
+					if( is_used[slot] or
+					    std::find( slots.begin( ), slots.end( ), slot ) !=
+					      slots.end( ) ) {
+						is_good = false;
+						break;
+					}
+					slots.push_back( slot );
+				}
+				if( is_good ) {
+					break;
+				}
+			}
+			if( displacement == max_displacement ) {
+				return false;
+			}
+			for( auto const slot : slots ) {
+				is_used[slot] = true;
+			}
+			m_displacements[bucket] = displacement;
+		}
+		return true;
+	}
+} // namespace daw::json::impl
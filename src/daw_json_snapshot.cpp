@@ -0,0 +1,407 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#include <daw/json/daw_json_file.h>
+#include <daw/json/daw_json_snapshot.h>
+#include <daw/json/daw_json_value_t.h>
+
+#include <daw/daw_string_view.h>
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace daw::json {
+	namespace {
+		static_assert( sizeof( double ) == sizeof( uint64_t ),
+		               "Reals are stored in 8 bytes" );
+
+		// Layout, all fields are 8 byte aligned relative to the start
+		//   header: magic[8], version u32, byte order marker u32, total size u64
+		//   node:   type u32, reserved u32, node size u64, payload
+		// Scalars have an 8 byte payload.  Strings hold their length and bytes.
+		// Arrays hold a count and one child offset per element, objects a count
+		// and a key offset and value offset per member, keys are string nodes.
+		// Child offsets are relative to the start of their parent node
+		constexpr char snapshot_magic[8] = { 'D', 'A', 'W', 'J',
+		                                     'S', 'N', 'A', 'P' };
+		constexpr uint32_t snapshot_version = 1;
+		constexpr uint32_t byte_order_marker = 0x01020304U;
+		constexpr size_t header_size = 24;
+		constexpr size_t node_header_size = 16;
+		// Each level costs only a few bytes of snapshot, so deeper values are
+		// rejected by to_json_value rather than risk exhausting the stack
+		constexpr size_t max_copy_depth = 512;
+
+		[[noreturn]] void throw_invalid_snapshot( char const *message ) {
+			throw std::runtime_error( std::string( "Invalid json snapshot: " ) +
+			                          message );
+		}
+
+		template<typename T>
+		T load( char const *ptr ) noexcept {
+			T result;
+			std::memcpy( &result, ptr, sizeof( T ) );
+			return result;
+		}
+
+		daw::string_view opened_file( json_file_t const &file ) {
+			if( not file ) {
+				throw std::runtime_error( "Could not open file" );
+			}
+			return file.to_string_view( );
+		}
+
+		constexpr size_t padded( size_t size ) noexcept {
+			return ( size + 7U ) & ~static_cast<size_t>( 7U );
+		}
+
+		class snapshot_writer_t {
+			std::string m_out{ };
+
+			template<typename T>
+			void store( size_t pos, T value ) {
+				std::memcpy( &m_out[pos], &value, sizeof( T ) );
+			}
+
+			/// @return position of the new node, its size is filled in by
+			/// end_node
+			size_t begin_node( json_snapshot_type_t type ) {
+				auto const pos = m_out.size( );
+				m_out.resize( pos + node_header_size );
+				store( pos, static_cast<uint32_t>( type ) );
+				store( pos + 4, static_cast<uint32_t>( 0 ) );
+				return pos;
+			}
+
+			void end_node( size_t pos ) {
+				m_out.resize( padded( m_out.size( ) ) );
+				store( pos + 8, static_cast<uint64_t>( m_out.size( ) - pos ) );
+			}
+
+			template<typename T>
+			void append( T value ) {
+				auto const pos = m_out.size( );
+				m_out.resize( pos + sizeof( T ) );
+				store( pos, value );
+			}
+
+			void add_scalar( json_snapshot_type_t type, uint64_t bits ) {
+				auto const pos = begin_node( type );
+				append( bits );
+				end_node( pos );
+			}
+
+			void add_string( daw::string_view str ) {
+				auto const pos = begin_node( json_snapshot_type_t::string );
+				append( static_cast<uint64_t>( str.size( ) ) );
+				m_out.append( str.data( ), str.size( ) );
+				end_node( pos );
+			}
+
+			/// @return position of a table of count entries of width u64's each
+			size_t add_table( size_t count, size_t width ) {
+				append( static_cast<uint64_t>( count ) );
+				auto const table = m_out.size( );
+				m_out.resize( table + count * width * sizeof( uint64_t ) );
+				return table;
+			}
+
+		public:
+			snapshot_writer_t( ) {
+				m_out.append( snapshot_magic, sizeof( snapshot_magic ) );
+				append( snapshot_version );
+				append( byte_order_marker );
+				append( static_cast<uint64_t>( 0 ) );
+			}
+
+			void add_value( json_value_t const &value ) {
+				if( value.is_null( ) ) {
+					add_scalar( json_snapshot_type_t::null, 0 );
+				} else if( value.is_boolean( ) ) {
+					add_scalar( json_snapshot_type_t::boolean,
+					            value.get_boolean( ) ? 1U : 0U );
+				} else if( value.is_integer( ) ) {
+					add_scalar( json_snapshot_type_t::integer,
+					            static_cast<uint64_t>(
+					              static_cast<int64_t>( value.get_integer( ) ) ) );
+				} else if( value.is_real( ) ) {
+					double const real = value.get_real( );
+					uint64_t bits = 0;
+					std::memcpy( &bits, &real, sizeof( bits ) );
+					add_scalar( json_snapshot_type_t::real, bits );
+				} else if( value.is_string( ) ) {
+					add_string( value.get_string( ) );
+				} else if( value.is_array( ) ) {
+					auto const &items = value.get_array( );
+					auto const pos = begin_node( json_snapshot_type_t::array );
+					auto const table = add_table( items.size( ), 1 );
+					for( size_t n = 0; n < items.size( ); ++n ) {
+						store( table + n * 8U,
+						       static_cast<uint64_t>( m_out.size( ) - pos ) );
+						add_value( items[n] );
+					}
+					end_node( pos );
+				} else {
+					auto const &members = value.get_object( ).container( );
+					auto const pos = begin_node( json_snapshot_type_t::object );
+					auto const table = add_table( members.size( ), 2 );
+					for( size_t n = 0; n < members.size( ); ++n ) {
+						store( table + n * 16U,
+						       static_cast<uint64_t>( m_out.size( ) - pos ) );
+						add_string( members[n].first.to_string( ) );
+						store( table + n * 16U + 8U,
+						       static_cast<uint64_t>( m_out.size( ) - pos ) );
+						add_value( members[n].second );
+					}
+					end_node( pos );
+				}
+			}
+
+			std::string take( ) {
+				store( 16, static_cast<uint64_t>( m_out.size( ) ) );
+				return std::move( m_out );
+			}
+		}; // snapshot_writer_t
+	} // namespace
+
+	json_snapshot_view_t::json_snapshot_view_t( char const *node,
+	                                            size_t available )
+	  : m_node( node )
+	  , m_size( 0 ) {
+
+		if( available < node_header_size + sizeof( uint64_t ) ) {
+			throw_invalid_snapshot( "node is truncated" );
+		}
+		auto const size = load<uint64_t>( node + 8 );
+		if( size < node_header_size + sizeof( uint64_t ) or size > available ) {
+			throw_invalid_snapshot( "node size is out of range" );
+		}
+		if( load<uint32_t>( node ) >
+		    static_cast<uint32_t>( json_snapshot_type_t::object ) ) {
+			throw_invalid_snapshot( "unknown node type" );
+		}
+		m_size = static_cast<size_t>( size );
+	}
+
+	uint64_t json_snapshot_view_t::load_u64( size_t offset ) const {
+		if( offset > m_size or m_size - offset < sizeof( uint64_t ) ) {
+			throw_invalid_snapshot( "offset is outside of its node" );
+		}
+		return load<uint64_t>( m_node + offset );
+	}
+
+	void json_snapshot_view_t::check_type( json_snapshot_type_t expected ) const {
+		if( type( ) != expected ) {
+			throw std::runtime_error( "Unexpected type in json snapshot" );
+		}
+	}
+
+	json_snapshot_view_t
+	json_snapshot_view_t::child( size_t table_offset ) const {
+		auto const offset = load_u64( table_offset );
+		// Children follow their parent's table, never overlap the header
+		if( offset <= node_header_size or offset >= m_size ) {
+			throw_invalid_snapshot( "child offset is outside of its parent" );
+		}
+		auto const pos = static_cast<size_t>( offset );
+		return json_snapshot_view_t( m_node + pos, m_size - pos );
+	}
+
+	json_snapshot_type_t json_snapshot_view_t::type( ) const noexcept {
+		return static_cast<json_snapshot_type_t>( load<uint32_t>( m_node ) );
+	}
+
+	bool json_snapshot_view_t::is_null( ) const noexcept {
+		return type( ) == json_snapshot_type_t::null;
+	}
+
+	bool json_snapshot_view_t::is_boolean( ) const noexcept {
+		return type( ) == json_snapshot_type_t::boolean;
+	}
+
+	bool json_snapshot_view_t::is_integer( ) const noexcept {
+		return type( ) == json_snapshot_type_t::integer;
+	}
+
+	bool json_snapshot_view_t::is_real( ) const noexcept {
+		return type( ) == json_snapshot_type_t::real;
+	}
+
+	bool json_snapshot_view_t::is_string( ) const noexcept {
+		return type( ) == json_snapshot_type_t::string;
+	}
+
+	bool json_snapshot_view_t::is_array( ) const noexcept {
+		return type( ) == json_snapshot_type_t::array;
+	}
+
+	bool json_snapshot_view_t::is_object( ) const noexcept {
+		return type( ) == json_snapshot_type_t::object;
+	}
+
+	bool json_snapshot_view_t::get_boolean( ) const {
+		check_type( json_snapshot_type_t::boolean );
+		return load_u64( node_header_size ) != 0;
+	}
+
+	json_value_t::integer_t json_snapshot_view_t::get_integer( ) const {
+		check_type( json_snapshot_type_t::integer );
+		return static_cast<json_value_t::integer_t>(
+		  static_cast<int64_t>( load_u64( node_header_size ) ) );
+	}
+
+	json_value_t::real_t json_snapshot_view_t::get_real( ) const {
+		check_type( json_snapshot_type_t::real );
+		(void)load_u64( node_header_size );
+		return load<double>( m_node + node_header_size );
+	}
+
+	daw::string_view json_snapshot_view_t::get_string( ) const {
+		check_type( json_snapshot_type_t::string );
+		auto const length = load_u64( node_header_size );
+		auto const first = node_header_size + sizeof( uint64_t );
+		if( length > m_size - first ) {
+			throw_invalid_snapshot( "string is longer than its node" );
+		}
+		return daw::string_view( m_node + first, static_cast<size_t>( length ) );
+	}
+
+	size_t json_snapshot_view_t::size( ) const {
+		if( not is_array( ) and not is_object( ) ) {
+			return 0;
+		}
+		auto const count = load_u64( node_header_size );
+		auto const width = is_array( ) ? 8U : 16U;
+		if( count > ( m_size - node_header_size - sizeof( uint64_t ) ) / width ) {
+			throw_invalid_snapshot( "child table is larger than its node" );
+		}
+		return static_cast<size_t>( count );
+	}
+
+	json_snapshot_view_t json_snapshot_view_t::operator[]( size_t index ) const {
+		check_type( json_snapshot_type_t::array );
+		if( index >= size( ) ) {
+			throw std::out_of_range( "Array index out of range" );
+		}
+		return child( node_header_size + sizeof( uint64_t ) + index * 8U );
+	}
+
+	daw::string_view json_snapshot_view_t::key_at( size_t index ) const {
+		check_type( json_snapshot_type_t::object );
+		if( index >= size( ) ) {
+			throw std::out_of_range( "Member index out of range" );
+		}
+		return child( node_header_size + sizeof( uint64_t ) + index * 16U )
+		  .get_string( );
+	}
+
+	json_snapshot_view_t json_snapshot_view_t::value_at( size_t index ) const {
+		check_type( json_snapshot_type_t::object );
+		if( index >= size( ) ) {
+			throw std::out_of_range( "Member index out of range" );
+		}
+		return child( node_header_size + sizeof( uint64_t ) + index * 16U + 8U );
+	}
+
+	std::optional<json_snapshot_view_t>
+	json_snapshot_view_t::find( daw::string_view key ) const {
+		auto const count = size( );
+		for( size_t n = 0; n < count; ++n ) {
+			if( key_at( n ) == key ) {
+				return value_at( n );
+			}
+		}
+		return std::nullopt;
+	}
+
+	namespace {
+		json_value_t copy_value( json_snapshot_view_t const &view, size_t depth ) {
+			if( depth > max_copy_depth ) {
+				throw_invalid_snapshot( "nesting is too deep" );
+			}
+			switch( view.type( ) ) {
+			case json_snapshot_type_t::null:
+				return json_value_t( );
+			case json_snapshot_type_t::boolean:
+				return json_value_t( view.get_boolean( ) );
+			case json_snapshot_type_t::integer:
+				return json_value_t( view.get_integer( ) );
+			case json_snapshot_type_t::real:
+				return json_value_t( view.get_real( ) );
+			case json_snapshot_type_t::string:
+				return json_value_t( view.get_string( ) );
+			case json_snapshot_type_t::array: {
+				auto const count = view.size( );
+				json_array_value items{ };
+				items.reserve( count );
+				for( size_t n = 0; n < count; ++n ) {
+					items.push_back( copy_value( view[n], depth + 1 ) );
+				}
+				return json_value_t( std::move( items ) );
+			}
+			case json_snapshot_type_t::object: {
+				auto const count = view.size( );
+				json_object_value members{ };
+				members.container( ).reserve( count );
+				for( size_t n = 0; n < count; ++n ) {
+					members.container( ).push_back( make_object_value_item(
+					  json_string_value( view.key_at( n ) ),
+					  copy_value( view.value_at( n ), depth + 1 ) ) );
+				}
+				return json_value_t( std::move( members ) );
+			}
+			}
+			throw_invalid_snapshot( "unknown node type" );
+		}
+	} // namespace
+
+	json_value_t json_snapshot_view_t::to_json_value( ) const {
+		return copy_value( *this, 0 );
+	}
+
+	std::string to_json_snapshot( json_value_t const &value ) {
+		snapshot_writer_t writer{ };
+		writer.add_value( value );
+		return writer.take( );
+	}
+
+	json_snapshot_view_t open_json_snapshot( daw::string_view data ) {
+		if( data.size( ) < header_size or
+		    std::memcmp( data.data( ), snapshot_magic, sizeof( snapshot_magic ) ) !=
+		      0 ) {
+			throw_invalid_snapshot( "missing header" );
+		}
+		if( load<uint32_t>( data.data( ) + 12 ) != byte_order_marker ) {
+			throw_invalid_snapshot( "written with another byte order" );
+		}
+		if( load<uint32_t>( data.data( ) + 8 ) != snapshot_version ) {
+			throw_invalid_snapshot( "unsupported version" );
+		}
+		if( load<uint64_t>( data.data( ) + 16 ) != data.size( ) ) {
+			throw_invalid_snapshot( "size does not match the header" );
+		}
+		return json_snapshot_view_t( data.data( ) + header_size,
+		                             data.size( ) - header_size );
+	}
+
+	void write_json_snapshot_file( daw::string_view file_name,
+	                               json_value_t const &value, bool overwrite ) {
+		write_json_file( file_name, to_json_snapshot( value ), overwrite, false );
+	}
+
+	json_snapshot_file_t::json_snapshot_file_t( daw::string_view file_name )
+	  : m_file( file_name )
+	  , m_root( open_json_snapshot( opened_file( m_file ) ) ) {}
+
+	json_snapshot_view_t json_snapshot_file_t::root( ) const noexcept {
+		return m_root;
+	}
+} // namespace daw::json
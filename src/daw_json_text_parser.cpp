@@ -0,0 +1,381 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#include <daw/json/daw_json_text_parser.h>
+
+#include <daw/daw_string_view.h>
+
+#include <boost/lexical_cast.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace daw::json::impl::text {
+	namespace {
+		uint32_t parse_hex4( char const *first, char const *last ) {
+			if( last - first < 4 ) {
+				throw_parse_error( "Unicode escape sequence was not properly formed" );
+			}
+			uint32_t result = 0;
+			for( size_t n = 0; n < 4; ++n ) {
+				auto const c = first[n];
+				result <<= 4U;
+				if( '0' <= c and c <= '9' ) {
+					result |= static_cast<uint32_t>( c - '0' );
+				} else if( 'a' <= c and c <= 'f' ) {
+					result |= static_cast<uint32_t>( c - 'a' + 10 );
+				} else if( 'A' <= c and c <= 'F' ) {
+					result |= static_cast<uint32_t>( c - 'A' + 10 );
+				} else {
+					throw_parse_error(
+					  "Unicode escape sequence was not properly formed" );
+				}
+			}
+			return result;
+		}
+
+		void append_utf8( uint32_t cp, std::string &out ) {
+			if( cp < 0x80U ) {
+				out += static_cast<char>( cp );
+			} else if( cp < 0x800U ) {
+				out += static_cast<char>( 0xC0U | ( cp >> 6U ) );
+				out += static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+			} else if( cp < 0x10000U ) {
+				out += static_cast<char>( 0xE0U | ( cp >> 12U ) );
+				out += static_cast<char>( 0x80U | ( ( cp >> 6U ) & 0x3FU ) );
+				out += static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+			} else {
+				out += static_cast<char>( 0xF0U | ( cp >> 18U ) );
+				out += static_cast<char>( 0x80U | ( ( cp >> 12U ) & 0x3FU ) );
+				out += static_cast<char>( 0x80U | ( ( cp >> 6U ) & 0x3FU ) );
+				out += static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+			}
+		}
+
+		// Deeper documents are rejected by check_value rather than risk
+		// exhausting the stack
+		constexpr size_t max_check_depth = 512;
+
+		constexpr bool is_digit( char c ) noexcept {
+			return '0' <= c and c <= '9';
+		}
+
+		bool check_digits( text_range_t &rng ) noexcept {
+			if( rng.empty( ) or not is_digit( *rng.first ) ) {
+				return false;
+			}
+			while( not rng.empty( ) and is_digit( *rng.first ) ) {
+				++rng.first;
+			}
+			return true;
+		}
+
+		bool check_value( text_range_t &rng, size_t depth ) noexcept {
+			if( rng.empty( ) or depth > max_check_depth ) {
+				return false;
+			}
+			switch( *rng.first ) {
+			case '"':
+				return check_string( rng );
+			case '{':
+				return check_object(
+				  rng, [depth]( daw::string_view, bool, text_range_t &member_rng ) {
+					  return check_value( member_rng, depth + 1 );
+				  } );
+			case '[':
+				return check_array( rng, [depth]( text_range_t &element_rng ) {
+					return check_value( element_rng, depth + 1 );
+				} );
+			case 't':
+			case 'f':
+				return check_boolean( rng );
+			case 'n':
+				return consume_literal( rng, "null" );
+			default:
+				return check_number( rng );
+			}
+		}
+
+		constexpr bool is_number_char( char c ) noexcept {
+			return ( '0' <= c and c <= '9' ) or c == '-' or c == '+' or c == '.' or
+			       c == 'e' or c == 'E';
+		}
+	} // namespace
+
+	void throw_parse_error( daw::string_view message ) {
+		throw std::runtime_error( "Error parsing json: " +
+		                          std::string( message.data( ), message.size( ) ) );
+	}
+
+	void unescape_string( daw::string_view escaped, std::string &out ) {
+		auto first = escaped.data( );
+		auto const last = escaped.data( ) + escaped.size( );
+		out.reserve( out.size( ) + escaped.size( ) );
+		while( first != last ) {
+			if( *first != '\\' ) {
+				out += *first++;
+				continue;
+			}
+			if( ++first == last ) {
+				throw_parse_error( "Unexpected end of data in escape sequence" );
+			}
+			switch( *first++ ) {
+			case '"':
+				out += '"';
+				break;
+			case '\\':
+				out += '\\';
+				break;
+			case '/':
+				out += '/';
+				break;
+			case 'b':
+				out += '\b';
+				break;
+			case 'f':
+				out += '\f';
+				break;
+			case 'n':
+				out += '\n';
+				break;
+			case 'r':
+				out += '\r';
+				break;
+			case 't':
+				out += '\t';
+				break;
+			case 'u': {
+				auto cp = parse_hex4( first, last );
+				first += 4;
+				if( 0xD800U <= cp and cp <= 0xDBFFU ) {
+					// High surrogate, a low surrogate must follow
+					if( last - first < 6 or first[0] != '\\' or first[1] != 'u' ) {
+						throw_parse_error( "Unicode surrogate pair is incomplete" );
+					}
+					auto const low = parse_hex4( first + 2, last );
+					if( low < 0xDC00U or low > 0xDFFFU ) {
+						throw_parse_error( "Unicode surrogate pair is invalid" );
+					}
+					cp = 0x10000U + ( ( cp - 0xD800U ) << 10U ) + ( low - 0xDC00U );
+					first += 6;
+				} else if( 0xDC00U <= cp and cp <= 0xDFFFU ) {
+					throw_parse_error( "Unicode surrogate pair is invalid" );
+				}
+				append_utf8( cp, out );
+				break;
+			}
+			default:
+				throw_parse_error( "Unknown escape sequence" );
+			}
+		}
+	}
+
+	json_value_t::real_t parse_real( text_range_t &rng ) {
+		auto const first = rng.first;
+		while( not rng.empty( ) and is_number_char( *rng.first ) ) {
+			++rng.first;
+		}
+		if( first == rng.first ) {
+			throw_parse_error( "Expected a number" );
+		}
+		try {
+			return boost::lexical_cast<json_value_t::real_t>(
+			  first, static_cast<size_t>( rng.first - first ) );
+		} catch( boost::bad_lexical_cast const & ) {
+			throw_parse_error( "Not a valid JSON number" );
+		}
+	}
+
+	bool check_string( text_range_t &rng ) noexcept {
+		if( not consume_if( rng, '"' ) ) {
+			return false;
+		}
+		while( not rng.empty( ) ) {
+			while( rng.size( ) >= 8 and
+			       not swar::has_string_special( swar::load( rng.first ) ) ) {
+				rng.first += 8;
+			}
+			if( rng.empty( ) ) {
+				return false;
+			}
+			auto const c = *rng.first++;
+			if( c == '"' ) {
+				return true;
+			}
+			if( static_cast<unsigned char>( c ) < 0x20U ) {
+				return false;
+			}
+			if( c != '\\' ) {
+				continue;
+			}
+			if( rng.empty( ) ) {
+				return false;
+			}
+			switch( *rng.first++ ) {
+			case '"':
+			case '\\':
+			case '/':
+			case 'b':
+			case 'f':
+			case 'n':
+			case 'r':
+			case 't':
+				break;
+			case 'u':
+				if( rng.size( ) < 4 ) {
+					return false;
+				}
+				for( size_t n = 0; n < 4; ++n ) {
+					auto const h = rng.first[n];
+					if( not( is_digit( h ) or ( 'a' <= h and h <= 'f' ) or
+					         ( 'A' <= h and h <= 'F' ) ) ) {
+						return false;
+					}
+				}
+				rng.first += 4;
+				break;
+			default:
+				return false;
+			}
+		}
+		return false;
+	}
+
+	bool check_integer( text_range_t &rng, json_value_t::integer_t min_value,
+	                    json_value_t::integer_t max_value ) noexcept {
+		using integer_t = json_value_t::integer_t;
+		using unsigned_t = std::make_unsigned_t<integer_t>;
+		bool const is_negative = consume_if( rng, '-' );
+		if( rng.empty( ) or not is_digit( *rng.first ) ) {
+			return false;
+		}
+		if( *rng.first == '0' and rng.size( ) > 1 and is_digit( rng.first[1] ) ) {
+			return false;
+		}
+		auto const limit =
+		  is_negative
+		    ? ( min_value < 0 ? static_cast<unsigned_t>( -( min_value + 1 ) ) + 1U
+		                      : static_cast<unsigned_t>( 0 ) )
+		    : ( max_value < 0 ? static_cast<unsigned_t>( 0 )
+		                      : static_cast<unsigned_t>( max_value ) );
+		unsigned_t result = 0;
+		while( not rng.empty( ) and is_digit( *rng.first ) ) {
+			auto const digit = static_cast<unsigned_t>( *rng.first - '0' );
+			if( result > ( limit - digit ) / 10U or limit < digit ) {
+				return false;
+			}
+			result = result * 10U + digit;
+			++rng.first;
+		}
+		if( not is_negative and
+		    static_cast<integer_t>( result ) < min_value ) {
+			return false;
+		}
+		return rng.empty( ) or
+		       not( *rng.first == '.' or *rng.first == 'e' or *rng.first == 'E' );
+	}
+
+	bool check_number( text_range_t &rng ) noexcept {
+		(void)consume_if( rng, '-' );
+		if( consume_if( rng, '0' ) ) {
+			if( not rng.empty( ) and is_digit( *rng.first ) ) {
+				return false;
+			}
+		} else if( not check_digits( rng ) ) {
+			return false;
+		}
+		if( consume_if( rng, '.' ) and not check_digits( rng ) ) {
+			return false;
+		}
+		if( consume_if( rng, 'e' ) or consume_if( rng, 'E' ) ) {
+			if( not consume_if( rng, '+' ) ) {
+				(void)consume_if( rng, '-' );
+			}
+			return check_digits( rng );
+		}
+		return true;
+	}
+
+	bool check_boolean( text_range_t &rng ) noexcept {
+		return consume_literal( rng, "true" ) or consume_literal( rng, "false" );
+	}
+
+	bool check_value( text_range_t &rng ) noexcept {
+		return check_value( rng, 0 );
+	}
+
+	void skip_value( text_range_t &rng ) {
+		if( rng.empty( ) ) {
+			throw_parse_error( "Unexpected end of data" );
+		}
+		switch( *rng.first ) {
+		case '"': {
+			bool has_escape = false;
+			(void)parse_raw_string( rng, has_escape );
+			return;
+		}
+		case '{':
+		case '[': {
+			size_t depth = 0;
+			while( not rng.empty( ) ) {
+				// Only quotes, brackets and braces matter here, step over words
+				// that hold none of them
+				while( rng.size( ) >= 8 and
+				       not swar::has_structural( swar::load( rng.first ) ) ) {
+					rng.first += 8;
+				}
+				if( rng.empty( ) ) {
+					break;
+				}
+				switch( *rng.first ) {
+				case '"': {
+					bool has_escape = false;
+					rng.first =
+					  find_string_end( rng.first + 1, rng.last, has_escape );
+					break;
+				}
+				case '{':
+				case '[':
+					++depth;
+					break;
+				case '}':
+				case ']':
+					if( --depth == 0 ) {
+						++rng.first;
+						return;
+					}
+					break;
+				default:
+					break;
+				}
+				++rng.first;
+			}
+			throw_parse_error( "Unexpected end of data in array or object" );
+		}
+		case 't':
+		case 'f':
+			(void)parse_boolean( rng );
+			return;
+		case 'n':
+			if( not consume_literal( rng, "null" ) ) {
+				throw_parse_error( "Expected null" );
+			}
+			return;
+		default: {
+			auto const first = rng.first;
+			while( not rng.empty( ) and is_number_char( *rng.first ) ) {
+				++rng.first;
+			}
+			if( first == rng.first ) {
+				throw_parse_error( "Unexpected character" );
+			}
+			return;
+		}
+		}
+	}
+} // namespace daw::json::impl::text
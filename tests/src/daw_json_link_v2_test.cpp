@@ -6,12 +6,25 @@
 // Official repository: https://github.com/beached/parse_json
 //
 
+#include "daw/json/daw_json_batch.h"
 #include "daw/json/daw_json_link.h"
+#include "daw/json/daw_json_link_stream.h"
+#include "daw/json/daw_json_snapshot.h"
 
+#include <algorithm>
+#include <atomic>
+#include <boost/filesystem.hpp>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 struct test_t final : public daw::json::json_link<test_t> {
@@ -55,6 +68,44 @@ struct test2_t : public daw::json::json_link<test2_t> {
 	}
 }; // test2_t
 
+struct test3_t : public daw::json::json_link<test3_t> {
+	test_t a;
+	std::vector<int64_t> b;
+	std::string c;
+	double d;
+	bool e;
+
+	static constexpr auto json_members( ) {
+		using daw::json::json_member;
+		return std::make_tuple(
+		  json_member( "a", &test3_t::a ), json_member( "b", &test3_t::b ),
+		  json_member( "c", &test3_t::c ), json_member( "d", &test3_t::d ),
+		  json_member( "e", &test3_t::e ) );
+	}
+}; // test3_t
+
+struct test5_t : public daw::json::json_link<test5_t> {
+	std::vector<bool> a;
+	std::string b;
+
+	static constexpr auto json_members( ) {
+		using daw::json::json_member;
+		return std::make_tuple( json_member( "flags", &test5_t::a ),
+		                        json_member( "say \"hi\"\\", &test5_t::b ) );
+	}
+}; // test5_t
+
+// Only used from the cold start threads below
+struct test4_t : public daw::json::json_link<test4_t> {
+	int64_t a;
+	std::string b;
+
+	static void map_to_json( ) {
+		json_link_integer( "a", a );
+		json_link_string( "b", b );
+	}
+}; // test4_t
+
 int main( int, char ** ) {
 	try {
 		test2_t t;
@@ -92,9 +143,370 @@ int main( int, char ** ) {
 		std::cout << t3str << '\n';
 
 		t.a = test_t::from_json_string( t3str );
+		{
+			std::istringstream t3stream( t3str );
+			test_t t3read;
+			t3stream >> t3read;
+			if( t3read.to_json_string( ) != t3str ) {
+				throw std::runtime_error( "Reading from a stream failed" );
+			}
+		}
 
 		std::cout << t.to_json_string( ) << '\n';
 
+		std::vector<test_t> many( 5000, t3 );
+		for( size_t n = 0; n < many.size( ); ++n ) {
+			many[n].c = static_cast<int64_t>( n );
+		}
+		std::string expected = "[";
+		for( auto const &item : many ) {
+			if( expected.size( ) > 1 ) {
+				expected += ',';
+			}
+			expected += item.to_json_string( );
+		}
+		expected += ']';
+		if( daw::json::array_to_json_string( many, 4 ) != expected ) {
+			throw std::runtime_error(
+			  "Parallel array serialization differs from sequential" );
+		}
+
+		{
+			auto const decoded =
+			  daw::json::array_from_string_parallel<test_t>( expected, 4 );
+			auto const decoded_dom =
+			  daw::json::array_from_json_value_parallel<test_t>(
+			    daw::json::parse_json( expected ), 4 );
+			if( decoded.size( ) != many.size( ) or
+			    decoded_dom.size( ) != many.size( ) ) {
+				throw std::runtime_error( "Parallel array decoding lost elements" );
+			}
+			for( size_t n = 0; n < many.size( ); ++n ) {
+				if( decoded[n].c != many[n].c or decoded_dom[n].c != many[n].c ) {
+					throw std::runtime_error( "Parallel array decoding out of order" );
+				}
+			}
+		}
+
+		{
+			// Several bad elements in different chunks, the lowest one must be
+			// reported however the threads are scheduled
+			std::string bad = "[";
+			for( size_t n = 0; n < 5000; ++n ) {
+				if( n > 0 ) {
+					bad += ',';
+				}
+				bad += n == 1500 or n == 3100 or n == 4500 ? R"({"b": "x"})" : t3str;
+			}
+			bad += ']';
+			for( size_t attempt = 0; attempt < 5; ++attempt ) {
+				std::string message{ };
+				try {
+					(void)daw::json::array_from_string_parallel<test_t>( bad, 4 );
+				} catch( std::runtime_error const &ex ) { message = ex.what( ); }
+				if( message.find( "element 1500:" ) == std::string::npos ) {
+					throw std::runtime_error(
+					  "Parallel decoding reported the wrong element: " + message );
+				}
+			}
+		}
+
+		{
+			// Strings full of separators and escapes so that a wrong guess about
+			// the string state at a chunk boundary would split an element
+			std::string big = "[";
+			for( size_t n = 0; n < 60000; ++n ) {
+				if( n > 0 ) {
+					big += ',';
+				}
+				big += R"({"s": "a,\"],[b\\", "n": [)" + std::to_string( n ) +
+				       R"(, 2.5, {"x": "}\\\""}], "t": true})";
+			}
+			big += " ]";
+			auto const sequential = daw::json::parse_json( big );
+			auto const parallel = daw::json::parse_json_parallel( big, 4 );
+			if( not sequential.is_array( ) or
+			    sequential.get_array( ).size( ) != 60000 or
+			    not( parallel == sequential ) ) {
+				throw std::runtime_error( "Parallel document parse differs" );
+			}
+		}
+
+		{
+			auto const text = daw::json::array_to_json_string( many );
+			daw::json::write_json_file( "link_gzip_test.json", text, true, true );
+			daw::json::json_file_t const in_file( "link_gzip_test.json" );
+			auto const is_same =
+			  in_file and in_file.is_compressed( ) and
+			  in_file.size( ) == text.size( ) and
+			  std::equal( in_file.begin( ), in_file.end( ), text.begin( ) );
+			auto const decoded =
+			  daw::json::array_from_file<test_t>( "link_gzip_test.json", false );
+			std::remove( "link_gzip_test.json" );
+			if( not is_same or decoded.size( ) != many.size( ) ) {
+				throw std::runtime_error( "Compressed file round trip failed" );
+			}
+
+			daw::json::write_json_file( "link_gzip_test.json", text, true, true );
+			std::string compressed{ };
+			{
+				std::ifstream gz_file( "link_gzip_test.json", std::ios::binary );
+				compressed.assign( std::istreambuf_iterator<char>( gz_file ),
+				                   std::istreambuf_iterator<char>( ) );
+			}
+			auto bad_header = compressed;
+			// Compression method 5 does not exist, only 8 (deflate) does
+			bad_header[2] = 5;
+			auto const half = compressed.substr( 0, compressed.size( ) / 2 );
+			daw::json::write_json_file( "link_gzip_test.json", half, true, false );
+			size_t rejected = 0;
+			for( auto const &data :
+			     { half, compressed.substr( 0, compressed.size( ) - 4 ),
+			       bad_header } ) {
+				try {
+					(void)daw::json::gzip_decompress( data );
+				} catch( std::runtime_error const & ) { ++rejected; }
+			}
+			try {
+				(void)daw::json::array_from_file<test_t>( "link_gzip_test.json",
+				                                          false );
+			} catch( std::runtime_error const & ) { ++rejected; }
+			std::remove( "link_gzip_test.json" );
+			if( rejected != 4 ) {
+				throw std::runtime_error( "Corrupt compressed data was accepted" );
+			}
+		}
+
+		{
+			daw::json::write_json_file( "link_empty_test.json", "", true, false );
+			daw::json::json_file_t const empty_file( "link_empty_test.json" );
+			auto const is_empty = empty_file and not empty_file.is_compressed( ) and
+			                      empty_file.size( ) == 0;
+			std::string message{ };
+			try {
+				daw::json::array_from_file<test_t>( "link_empty_test.json", false );
+			} catch( std::exception const &ex ) { message = ex.what( ); }
+			std::remove( "link_empty_test.json" );
+			daw::json::json_file_t const missing_file( "link_empty_test.json" );
+			auto const open_failed =
+			  message.find( "Could not open" ) != std::string::npos;
+			if( not is_empty or open_failed or missing_file ) {
+				throw std::runtime_error( "Empty file handling failed" );
+			}
+		}
+
+		daw::json::write_json_file( "link_stream_test.json",
+		                            daw::json::array_to_json_string( many ), true,
+		                            false );
+		size_t streamed_count = 0;
+		for( auto const &item : daw::json::array_range_from_file<test_t>(
+		       "link_stream_test.json" ) ) {
+			if( item.c != static_cast<int64_t>( streamed_count ) ) {
+				throw std::runtime_error( "Streamed element differs" );
+			}
+			++streamed_count;
+		}
+		size_t batched_count = 0;
+		daw::json::array_from_file_batched<test_t>(
+		  "link_stream_test.json", 1000,
+		  [&batched_count]( std::vector<test_t> &batch ) {
+			  batched_count += batch.size( );
+		  } );
+		if( streamed_count != many.size( ) or batched_count != many.size( ) ) {
+			throw std::runtime_error( "Streamed element count differs" );
+		}
+
+		auto const t4 = test_t::from_json_string(
+		  R"({ "unknown": { "x": [1, "]}", {}] }, "d": "a\"b\u00e9", "b": -5,
+		       "long_unknown": [ "a long string with \"escaped\" ]} text",
+		                         { "nested": [ [ [ 12345678901234 ] ] ] } ],
+		       "a": [ 1, 2 ], "e": 1e2, "g": true })" );
+		if( t4.d != "a\"b\xC3\xA9" or t4.b != -5 or t4.a.size( ) != 2 or
+		    t4.e != 100.0 or not t4.g ) {
+			throw std::runtime_error( "Direct text decoding failed" );
+		}
+
+		{
+			// Longer than any small string buffer, so d's data is on the heap
+			auto long_value = t3;
+			long_value.d = "a string that is too long for the small string buffer";
+			auto const long_str = long_value.to_json_string( );
+			test_t reused;
+			test_t::decode_into( reused, long_str );
+			auto const vector_data = reused.a.data( );
+			auto const string_data = reused.d.data( );
+			test_t::decode_into( reused, long_str );
+			if( reused.a.data( ) != vector_data or reused.d.data( ) != string_data or
+			    reused.to_json_string( ) != long_str ) {
+				throw std::runtime_error( "decode_into did not reuse capacity" );
+			}
+		}
+
+		if( not test_t::is_valid_json( t3str ) or
+		    not test3_t::is_valid_json(
+		      R"({"a":)" + t3str +
+		      R"(,"b":[1],"c":"x","d":1,"e":false,"extra":{"k":[null]}})" ) or
+		    test_t::is_valid_json( R"({"a":[],"b":1,"c":1,"d":"","e":1})" ) or
+		    test_t::is_valid_json(
+		      R"({"a":[],"b":1,"c":1,"d":"","e":1,"f":40000,"g":true})" ) or
+		    test_t::is_valid_json(
+		      R"({"a":[],"b":1,"c":1,"d":"","e":1,"f":1,"g":true,"h":[})" ) ) {
+			throw std::runtime_error( "Validation gave the wrong answer" );
+		}
+
+		test3_t t5;
+		t5.a = t3;
+		t5.b = { 1, -2, 3 };
+		t5.c = "members";
+		t5.d = 1.5;
+		t5.e = true;
+		auto const t5str = t5.to_json_string( );
+		std::cout << t5str << '\n';
+		auto const t6 = test3_t::from_json_string( t5str );
+		auto const t7 =
+		  test3_t::from_json_value( daw::json::parse_json( t5str ) );
+		if( t6.to_json_string( ) != t5str or t7.to_json_string( ) != t5str ) {
+			throw std::runtime_error( "Compile time member table round trip failed" );
+		}
+
+		{
+			// Names chosen so that they all fall into one bucket of the first
+			// hash, every one of them has to be placed by displacement
+			constexpr size_t key_count = 48;
+			std::vector<std::pair<std::string, size_t>> items{ };
+			for( size_t n = 0; items.size( ) < key_count; ++n ) {
+				auto name = "member_" + std::to_string( n );
+				if( daw::json::impl::perfect_hash_value( name, 0 ) % key_count ==
+				    0 ) {
+					items.emplace_back( daw::move( name ), items.size( ) );
+				}
+			}
+			auto const index =
+			  daw::json::impl::perfect_hash_map_t<size_t>( items );
+			for( auto const &item : items ) {
+				auto const found = index.find( item.first );
+				if( not found or *found != item.second ) {
+					throw std::runtime_error( "Colliding member name not found" );
+				}
+			}
+			if( index.find( "member_x" ) or index.find( "" ) ) {
+				throw std::runtime_error( "Unknown member name was found" );
+			}
+		}
+
+		{
+			test5_t t9;
+			t9.a = { true, false, true };
+			t9.b = "escaped name";
+			auto const t9str = t9.to_json_string( );
+			auto const t10 = test5_t::from_json_string( t9str );
+			// parse_json keeps escapes in member names, so only the unescaped
+			// name is compared on that path
+			auto const t11 =
+			  test5_t::from_json_value( daw::json::parse_json( t9str ) );
+			if( not test5_t::is_valid_json( t9str ) or t10.a != t9.a or
+			    t10.b != t9.b or t11.a != t9.a ) {
+				throw std::runtime_error( "Escaped member name round trip failed" );
+			}
+		}
+
+		{
+			std::atomic<size_t> good_count{ 0 };
+			std::vector<std::thread> threads{ };
+			for( size_t n = 0; n < 8; ++n ) {
+				threads.emplace_back( [&good_count]( ) {
+					auto const t8 =
+					  test4_t::from_json_string( R"({ "a": 42, "b": "cold" })" );
+					if( t8.a == 42 and t8.b == "cold" ) {
+						++good_count;
+					}
+				} );
+			}
+			for( auto &th : threads ) {
+				th.join( );
+			}
+			if( good_count != threads.size( ) ) {
+				throw std::runtime_error( "Concurrent first use decoding failed" );
+			}
+		}
+
+		{
+			boost::filesystem::create_directory( "batch_test_dir" );
+			std::vector<std::string> paths{ };
+			for( size_t n = 0; n < 40; ++n ) {
+				paths.push_back( "batch_test_dir/" + std::to_string( 100 + n ) +
+				                 ".json" );
+				daw::json::write_json_file(
+				  paths.back( ), R"({"n": )" + std::to_string( n ) + "}", true,
+				  false );
+			}
+			paths.push_back( "batch_test_dir/malformed.json" );
+			daw::json::write_json_file( paths.back( ), R"({"n": [1, 2})", true,
+			                            false );
+			paths.push_back( "batch_test_dir/missing.json" );
+			auto const results = daw::json::parse_files( paths, 3 );
+			auto const dir_results =
+			  daw::json::parse_directory( "batch_test_dir", 3 );
+			boost::filesystem::remove_all( "batch_test_dir" );
+			if( results.size( ) != paths.size( ) or dir_results.size( ) != 41 or
+			    not results[40].has_error( ) or not results[41].has_error( ) or
+			    not dir_results[40].has_error( ) ) {
+				throw std::runtime_error( "Batch file parsing lost files" );
+			}
+			for( size_t n = 0; n < 40; ++n ) {
+				for( auto const &result : { results[n], dir_results[n] } ) {
+					if( result.has_error( ) or result.path != paths[n] or
+					    result.value.get_object( ).find( "n" )->second.get_integer( ) !=
+					      static_cast<int64_t>( n ) ) {
+						throw std::runtime_error( "Batch file result differs" );
+					}
+				}
+			}
+		}
+
+		{
+			auto const doc = daw::json::parse_json(
+			  R"({"name": "snap", "n": -42, "r": 2.5, "ok": true, "none": null,)"
+			  R"( "list": [1, "two", [3.25, false], {}], "nested": {"k": "v"}})" );
+			daw::json::write_json_snapshot_file( "link_snapshot_test.bin", doc );
+			daw::json::json_snapshot_file_t const snapshot(
+			  "link_snapshot_test.bin" );
+			auto const root = snapshot.root( );
+			auto const list = root.find( "list" );
+			auto const is_same = root.to_json_value( ) == doc;
+			auto const is_view_right =
+			  root.size( ) == 7 and root.key_at( 0 ) == "name" and
+			  root.find( "n" )->get_integer( ) == -42 and list and
+			  list->size( ) == 4 and ( *list )[1].get_string( ) == "two" and
+			  ( *list )[2][0].get_real( ) == 3.25 and
+			  not root.find( "missing" ) and
+			  root.find( "nested" )->find( "k" )->get_string( ) == "v";
+			std::remove( "link_snapshot_test.bin" );
+			if( not is_same or not is_view_right ) {
+				throw std::runtime_error( "Snapshot round trip failed" );
+			}
+
+			auto const bytes = daw::json::to_json_snapshot( doc );
+			auto corrupt = bytes;
+			// The root node's size, larger than the data that holds it
+			corrupt[32 + 7] = '\x7F';
+			size_t rejected = 0;
+			for( auto const &data : { bytes.substr( 1 ), corrupt } ) {
+				try {
+					(void)daw::json::open_json_snapshot( data );
+				} catch( std::runtime_error const & ) { ++rejected; }
+			}
+			auto const deep_bytes = daw::json::to_json_snapshot(
+			  daw::json::parse_json( std::string( 1000, '[' ) +
+			                         std::string( 1000, ']' ) ) );
+			try {
+				(void)daw::json::open_json_snapshot( deep_bytes ).to_json_value( );
+			} catch( std::runtime_error const & ) { ++rejected; }
+			if( rejected != 3 ) {
+				throw std::runtime_error( "Invalid snapshot was accepted" );
+			}
+		}
+
 		auto const f = daw::json::array_from_file<test2_t>( "test.json", true );
 
 		for( auto const &item : f ) {
@@ -0,0 +1,563 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/parse_json
+//
+
+#include "daw/json/daw_json_async_io.h"
+#include "daw/json/daw_json_dom_builder.h"
+#include "daw/json/daw_json_lines.h"
+#include "daw/json/daw_json_parser.h"
+#include "daw/json/daw_json_parser_v2.h"
+#include "daw/json/daw_json_parser_v2_state.h"
+#include "daw/json/daw_json_path.h"
+#include "daw/json/daw_json_push_parser.h"
+
+#include <daw/daw_string_view.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+	// Records the events it receives as a compact string
+	struct recording_handler_t : daw::json::json_handler_base {
+		std::string events{ };
+
+		void on_object_begin( ) {
+			events += '{';
+		}
+
+		void on_object_end( ) {
+			events += '}';
+		}
+
+		void on_array_begin( ) {
+			events += '[';
+		}
+
+		void on_array_end( ) {
+			events += ']';
+		}
+
+		void on_key( daw::string_view key ) {
+			events += "k:" + std::string( key.data( ), key.size( ) ) + ' ';
+		}
+
+		void on_string( daw::string_view value ) {
+			events += "s:" + std::string( value.data( ), value.size( ) ) + ' ';
+		}
+
+		void on_integer( daw::string_view value ) {
+			events += "i:" + std::string( value.data( ), value.size( ) ) + ' ';
+		}
+
+		void on_real( daw::string_view value ) {
+			events += "r:" + std::string( value.data( ), value.size( ) ) + ' ';
+		}
+
+		void on_boolean( bool value ) {
+			events += value ? "true " : "false ";
+		}
+
+		void on_null( ) {
+			events += "null ";
+		}
+	}; // recording_handler_t
+
+	// Only cares about keys, everything else goes to the no-op base
+	struct key_counter_t : daw::json::json_handler_base {
+		size_t count = 0;
+
+		void on_key( daw::string_view ) {
+			++count;
+		}
+	}; // key_counter_t
+
+	// Wants the converted numbers and checks where the text lives
+	struct value_handler_t : daw::json::json_handler_base {
+		daw::string_view input{ };
+		intmax_t integer_sum = 0;
+		double real_sum = 0.0;
+		std::string strings{ };
+		size_t views_into_input = 0;
+
+		void count_view( daw::string_view value ) {
+			if( input.data( ) <= value.data( ) and
+			    value.data( ) + value.size( ) <= input.data( ) + input.size( ) ) {
+				++views_into_input;
+			}
+		}
+
+		void on_key( daw::string_view key ) {
+			count_view( key );
+		}
+
+		void on_string( daw::string_view value ) {
+			count_view( value );
+			strings += std::string( value.data( ), value.size( ) ) + '|';
+		}
+
+		void on_integer( daw::string_view value, intmax_t number ) {
+			count_view( value );
+			integer_sum += number;
+		}
+
+		void on_real( daw::string_view value, double number ) {
+			count_view( value );
+			real_sum += number;
+		}
+	}; // value_handler_t
+
+	// Keeps the first integer of a record
+	struct record_handler_t : daw::json::json_handler_base {
+		intmax_t value = -1;
+
+		void on_integer( daw::string_view, intmax_t number ) {
+			if( value < 0 ) {
+				value = number;
+			}
+		}
+	}; // record_handler_t
+
+	// Skips the member "skip", the contents of any array and stops at the
+	// first string after the member "id"
+	struct control_handler_t : recording_handler_t {
+		bool is_id = false;
+
+		daw::json::parse_control_t on_key( daw::string_view key ) {
+			recording_handler_t::on_key( key );
+			is_id = key == "id";
+			return key == "skip" ? daw::json::parse_control_t::skip
+			                     : daw::json::parse_control_t::proceed;
+		}
+
+		daw::json::parse_control_t on_array_begin( ) {
+			recording_handler_t::on_array_begin( );
+			return daw::json::parse_control_t::skip;
+		}
+
+		daw::json::parse_control_t on_string( daw::string_view value ) {
+			recording_handler_t::on_string( value );
+			return is_id ? daw::json::parse_control_t::stop
+			             : daw::json::parse_control_t::proceed;
+		}
+	}; // control_handler_t
+
+	void expect( bool condition, char const *message ) {
+		if( not condition ) {
+			throw std::runtime_error( message );
+		}
+	}
+
+	template<typename Handler>
+	void parse( daw::string_view json_text, Handler &handler ) {
+		daw::json::json_parser( json_text.data( ),
+		                        json_text.data( ) + json_text.size( ), handler );
+	}
+
+	void test_events( ) {
+		recording_handler_t handler{ };
+		parse( R"({"a": "b", "c": [1, 2.5, true, null], "d": {}})", handler );
+		expect( handler.events ==
+		          "{k:a s:b k:c [i:1 r:2.5 true null ]k:d {}}",
+		        "Unexpected event sequence" );
+	}
+
+	void test_base_handler( ) {
+		key_counter_t handler{ };
+		parse( R"([{"a": 1, "b": {"c": "d"}}, {"e": []}])", handler );
+		expect( handler.count == 4, "Wrong number of keys" );
+	}
+
+	void test_values( ) {
+		daw::string_view const json_text =
+		  R"({"a": [1, -20, 300], "b": 2.5e1, "c": "plain", )"
+		  R"("d": "q\"s\\", "e": "\u00e9"})";
+		value_handler_t handler{ };
+		handler.input = json_text;
+		parse( json_text, handler );
+		expect( handler.integer_sum == 281, "Wrong integer values" );
+		expect( handler.real_sum == 25.0, "Wrong real values" );
+		expect( handler.strings == "plain|q\"s\\|\xC3\xA9|",
+		        "Escapes were not decoded" );
+		// 5 keys, 4 numbers and the one string without escapes
+		expect( handler.views_into_input == 10,
+		        "Tokens were copied out of contiguous input" );
+
+		std::string const copied( json_text.data( ), json_text.size( ) );
+		recording_handler_t recorder{ };
+		daw::json::json_parser( copied.begin( ), copied.end( ), recorder );
+		expect( recorder.events == "{k:a [i:1 i:-20 i:300 ]k:b r:2.5e1 k:c "
+		                           "s:plain k:d s:q\"s\\ k:e s:\xC3\xA9 }",
+		        "Non contiguous input gave different events" );
+	}
+
+	void test_push_parser( ) {
+		daw::string_view const json_text =
+		  R"({"a": [1, -2.5e3, true, false, null], "b": "x\"y\\",)"
+		  R"( "c": {"d": [], "e": {}}, "f": 12345}  [ "next" ])";
+		recording_handler_t expected{ };
+		parse( json_text, expected );
+
+		// Every way of splitting the text in two, then one byte at a time
+		for( size_t split = 0; split <= json_text.size( ); ++split ) {
+			recording_handler_t handler{ };
+			daw::json::json_push_parser<recording_handler_t> parser( handler );
+			parser.feed( json_text.substr( 0, split ) );
+			parser.feed( json_text.substr( split ) );
+			parser.finish( );
+			expect( handler.events == expected.events,
+			        "Push parser events differ at a chunk boundary" );
+		}
+		recording_handler_t handler{ };
+		daw::json::json_push_parser<recording_handler_t> parser( handler );
+		for( auto const &c : json_text ) {
+			parser.feed( &c, &c + 1 );
+		}
+		parser.finish( );
+		expect( handler.events == expected.events,
+		        "Push parser events differ when fed single bytes" );
+
+		daw::json::json_push_parser<recording_handler_t> partial( handler );
+		partial.feed( daw::string_view( R"({"a": [1, 2)" ) );
+		expect( partial.depth( ) == 2, "Push parser lost its nesting" );
+		bool threw = false;
+		try {
+			partial.finish( );
+		} catch( daw::json::json_parser_exception const & ) {
+			threw = true;
+		}
+		expect( threw, "Incomplete document was accepted" );
+	}
+
+	void test_json_lines( ) {
+		using daw::json::json_lines_order_t;
+		// Enough records to be split into several chunks
+		constexpr intmax_t record_count = 100000;
+		std::string data{ };
+		for( intmax_t n = 0; n < record_count; ++n ) {
+			if( n % 3 == 0 ) {
+				data += std::to_string( n ) + "\r\n";
+			} else {
+				data += R"({"n": )" + std::to_string( n ) +
+				        R"(, "s": "padding padding padding"})" + "\n\n";
+			}
+		}
+		auto const make_handler = []( ) { return record_handler_t{ }; };
+
+		intmax_t expected_next = 0;
+		daw::json::json_lines_parser(
+		  data, make_handler,
+		  [&expected_next]( record_handler_t &&record ) {
+			  expect( record.value == expected_next, "Record out of order" );
+			  ++expected_next;
+		  },
+		  json_lines_order_t::in_order, 4 );
+		expect( expected_next == record_count, "Records were lost" );
+
+		intmax_t sum = 0;
+		daw::json::json_lines_parser(
+		  data, make_handler,
+		  [&sum]( record_handler_t &&record ) { sum += record.value; },
+		  json_lines_order_t::unordered, 4 );
+		expect( sum == record_count * ( record_count - 1 ) / 2,
+		        "Unordered records were lost" );
+
+		std::string message{ };
+		try {
+			daw::json::json_lines_parser( daw::string_view( "1\n\n[2]\n{3}\n" ),
+			                              make_handler,
+			                              []( record_handler_t && ) {} );
+		} catch( daw::json::json_parser_exception const &ex ) {
+			message = ex.what( );
+		}
+		expect( message.find( "line 4" ) != std::string::npos,
+		        "Error did not name the failing line" );
+	}
+
+	void test_dom_builder( ) {
+		daw::string_view const json_text =
+		  R"({"a": [1, -2.5, {"b": [[], {}]}, "c"], "d": {"e": null},)"
+		  R"( "f": true, "g": false, "h": 9007199254740993})";
+		auto const expected = daw::json::parse_json( json_text );
+		expect( daw::json::build_json_value( json_text ) == expected,
+		        "DOM built from events differs from parse_json" );
+
+		daw::json::json_dom_builder_t builder{ };
+		daw::json::json_push_parser<daw::json::json_dom_builder_t> parser(
+		  builder );
+		parser.feed( json_text.substr( 0, 20 ) );
+		parser.feed( json_text.substr( 20 ) );
+		parser.finish( );
+		expect( builder.take_value( ) == expected,
+		        "DOM built from pushed chunks differs from parse_json" );
+	}
+
+	std::vector<daw::json::json_value_t> select( daw::string_view path,
+	                                             daw::string_view json_text ) {
+		daw::json::json_path_t const compiled( path );
+		daw::json::json_dom_builder_t builder{ };
+		daw::json::json_path_filter_t<daw::json::json_dom_builder_t> filter(
+		  compiled, builder );
+		parse( json_text, filter );
+		expect( filter.match_count( ) == builder.values( ).size( ),
+		        "Match count differs from values delivered" );
+		return std::move( builder.values( ) );
+	}
+
+	void test_json_path( ) {
+		daw::string_view const json_text =
+		  R"({"events": [{"user": {"id": 1, "name": "a"}}, {"user": {"id": 2}},)"
+		  R"( {"other": {"id": 99}}], "meta": {"id": "m", "list": [5, 6]}})";
+		auto const ids = select( "$.events[*].user.id", json_text );
+		expect( ids.size( ) == 2 and ids[0].get_integer( ) == 1 and
+		          ids[1].get_integer( ) == 2,
+		        "Child and wildcard selection failed" );
+		expect( select( "$..id", json_text ).size( ) == 4,
+		        "Recursive descent selection failed" );
+		auto const second = select( "$.events[1]", json_text );
+		expect( second.size( ) == 1 and second[0].is_object( ),
+		        "Index selection failed" );
+		auto const meta = select( "$['meta'].list[1]", json_text );
+		expect( meta.size( ) == 1 and meta[0].get_integer( ) == 6,
+		        "Quoted name selection failed" );
+		expect( select( "$", json_text ).size( ) == 1, "Root selection failed" );
+		expect( select( "$.missing..id", json_text ).empty( ),
+		        "Selection under a missing member matched" );
+
+		bool threw = false;
+		try {
+			daw::json::json_path_t const bad( "events[0" );
+		} catch( daw::json::json_parser_exception const & ) {
+			threw = true;
+		}
+		expect( threw, "Invalid path was accepted" );
+
+		threw = false;
+		try {
+			daw::json::json_path_t const too_large( "$[99999999999999999999999]" );
+		} catch( daw::json::json_parser_exception const & ) {
+			threw = true;
+		}
+		expect( threw, "Overflowing index was accepted" );
+	}
+
+	void test_block_reader( ) {
+		std::string const json_text =
+		  R"([{"a": "a long enough string", "b": [1, 2.5e10, null]}, )"
+		  R"({"c": "x\"y", "d": -12345678}, true])";
+		recording_handler_t expected{ };
+		parse( json_text, expected );
+
+		std::istringstream stream( json_text );
+		recording_handler_t from_stream{ };
+		daw::json::json_parse_stream( stream, from_stream, 7 );
+		expect( from_stream.events == expected.events,
+		        "Events from a stream differ" );
+
+		int fds[2];
+		expect( ::pipe( fds ) == 0, "Could not create a pipe" );
+		expect( ::write( fds[1], json_text.data( ), json_text.size( ) ) ==
+		          static_cast<ssize_t>( json_text.size( ) ),
+		        "Could not write to the pipe" );
+		::close( fds[1] );
+		recording_handler_t from_fd{ };
+		daw::json::json_parse_fd( fds[0], from_fd, 5 );
+		::close( fds[0] );
+		expect( from_fd.events == expected.events,
+		        "Events from a file descriptor differ" );
+	}
+
+	void test_async_file( ) {
+		std::string json_text = "[";
+		for( size_t n = 0; n < 200; ++n ) {
+			json_text += R"({"n": )" + std::to_string( n ) +
+			             R"(, "s": "a \"quoted\" string", "v": [1.5, null]},)";
+		}
+		json_text += "true]";
+		recording_handler_t expected{ };
+		parse( json_text, expected );
+
+		auto const file_name = "sax_async_test.json";
+		bool write_after_close_threw = false;
+		{
+			daw::json::json_async_file_writer_t writer( file_name, 2 );
+			for( size_t pos = 0; pos < json_text.size( ); pos += 100 ) {
+				writer.write( json_text.substr( pos, 100 ) );
+			}
+			writer.close( );
+			try {
+				writer.write( "lost" );
+			} catch( std::runtime_error const & ) {
+				write_after_close_threw = true;
+			}
+		}
+		expect( write_after_close_threw, "Writing after close did not throw" );
+		recording_handler_t from_file{ };
+		daw::json::json_parse_file( file_name, from_file, 7, 3 );
+		std::remove( file_name );
+		expect( from_file.events == expected.events,
+		        "Events from an asynchronously read file differ" );
+
+		bool threw = false;
+		try {
+			daw::json::json_async_file_reader_t const missing(
+			  "sax_async_missing.json" );
+		} catch( std::runtime_error const & ) {
+			threw = true;
+		}
+		expect( threw, "Opening a missing file did not throw" );
+	}
+
+	void test_parse_control( ) {
+		std::string const json_text =
+		  R"({"skip": {"a": [1, "}"]}, "b": [2, {"c": 3}], "d": null,)"
+		  R"( "id": "x", "e": "never reached"})";
+		std::string const expected_events = "{k:skip k:b []k:d null k:id s:x ";
+		auto const stop_offset = json_text.find( R"("x")" ) + 3;
+
+		control_handler_t handler{ };
+		auto const stopped_at = daw::json::json_parser(
+		  json_text.data( ), json_text.data( ) + json_text.size( ), handler );
+		expect( handler.events == expected_events,
+		        "Skipped or stopped events were reported" );
+		expect( stopped_at == json_text.data( ) + stop_offset,
+		        "Wrong stop position" );
+
+		control_handler_t from_iterators{ };
+		auto const stopped_it = daw::json::json_parser(
+		  json_text.begin( ), json_text.end( ), from_iterators );
+		expect( from_iterators.events == expected_events and
+		          stopped_it == json_text.begin( ) + stop_offset,
+		        "Skipping non contiguous input failed" );
+
+		control_handler_t pushed{ };
+		daw::json::json_push_parser<control_handler_t> parser( pushed );
+		size_t consumed = 0;
+		for( auto const &c : json_text ) {
+			consumed += parser.feed( &c, &c + 1 );
+		}
+		parser.finish( );
+		expect( pushed.events == expected_events and parser.is_stopped( ) and
+		          consumed == stop_offset,
+		        "Skipping or stopping the push parser failed" );
+	}
+
+	void test_state_control( ) {
+		daw::json::state::state_control_t handler{ };
+		parse( R"({"a": [1, {"b": "c"}], "d": null})", handler );
+		expect( handler.current_state( ).to_string( ) == "state_none",
+		        "state_control_t did not return to the start state" );
+	}
+
+	std::string make_document( size_t n ) {
+		auto const id = std::to_string( n );
+		std::string result = R"({"id": )" + id + R"(, "items": [)";
+		for( size_t i = 0; i <= n % 7; ++i ) {
+			result += R"({"k": "v)" + id + R"(", "a": [)" + std::to_string( i ) +
+			          R"(, 2.5, null, true]},)";
+		}
+		return result + R"( {}], "name": "doc)" + id + R"("})";
+	}
+
+	void test_concurrent_parses( ) {
+		constexpr size_t thread_count = 8;
+		std::vector<std::string> documents{ };
+		std::vector<std::string> expected{ };
+		for( size_t n = 0; n < thread_count; ++n ) {
+			documents.push_back( make_document( n ) );
+			recording_handler_t handler{ };
+			parse( documents.back( ), handler );
+			expected.push_back( handler.events );
+		}
+
+		std::atomic<size_t> failures{ 0 };
+		std::vector<std::thread> threads{ };
+		for( size_t n = 0; n < thread_count; ++n ) {
+			threads.emplace_back( [&, n]( ) {
+				try {
+					for( size_t pass = 0; pass < 200; ++pass ) {
+						recording_handler_t handler{ };
+						parse( documents[n], handler );
+						daw::json::state::state_control_t state{ };
+						parse( documents[n], state );
+						if( handler.events != expected[n] or
+						    state.current_state( ).to_string( ) != "state_none" ) {
+							++failures;
+						}
+					}
+				} catch( ... ) { ++failures; }
+			} );
+		}
+		for( auto &t : threads ) {
+			t.join( );
+		}
+		expect( failures == 0, "Concurrent parses interfered" );
+
+		// Two parses interleaved on one thread, a character at a time
+		daw::json::state::state_control_t first_state{ };
+		daw::json::state::state_control_t second_state{ };
+		recording_handler_t first{ };
+		recording_handler_t second{ };
+		daw::json::json_push_parser<daw::json::state::state_control_t>
+		  first_state_parser( first_state );
+		daw::json::json_push_parser<daw::json::state::state_control_t>
+		  second_state_parser( second_state );
+		daw::json::json_push_parser<recording_handler_t> first_parser( first );
+		daw::json::json_push_parser<recording_handler_t> second_parser( second );
+		auto const &a = documents[1];
+		auto const &b = documents[6];
+		for( size_t pos = 0; pos < std::max( a.size( ), b.size( ) ); ++pos ) {
+			if( pos < a.size( ) ) {
+				first_parser.feed( &a[pos], &a[pos] + 1 );
+				first_state_parser.feed( &a[pos], &a[pos] + 1 );
+			}
+			if( pos < b.size( ) ) {
+				second_parser.feed( &b[pos], &b[pos] + 1 );
+				second_state_parser.feed( &b[pos], &b[pos] + 1 );
+			}
+		}
+		first_parser.finish( );
+		second_parser.finish( );
+		first_state_parser.finish( );
+		second_state_parser.finish( );
+		expect( first.events == expected[1] and second.events == expected[6] and
+		          first_state.current_state( ).to_string( ) == "state_none" and
+		          second_state.current_state( ).to_string( ) == "state_none",
+		        "Interleaved parses interfered" );
+	}
+} // namespace
+
+int main( int, char ** ) {
+	try {
+		test_events( );
+		test_base_handler( );
+		test_values( );
+		test_push_parser( );
+		test_json_lines( );
+		test_dom_builder( );
+		test_json_path( );
+		test_block_reader( );
+		test_async_file( );
+		test_parse_control( );
+		test_state_control( );
+		test_concurrent_parses( );
+	} catch( std::exception const &ex ) {
+		std::cerr << "Exception caught: " << ex.what( ) << '\n';
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}